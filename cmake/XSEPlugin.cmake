@@ -39,6 +39,13 @@ set_property(GLOBAL PROPERTY USE_FOLDERS ON)
 include(AddCXXFiles)
 add_cxx_files("${PROJECT_NAME}")
 
+# Everything but the game backend lives in the core library
+target_link_libraries(
+	"${PROJECT_NAME}"
+	PRIVATE
+	"${PROJECT_NAME}Core"
+)
+
 configure_file(
 	${CMAKE_CURRENT_SOURCE_DIR}/cmake/Plugin.h.in
 	${CMAKE_CURRENT_BINARY_DIR}/cmake/Plugin.h
@@ -0,0 +1,44 @@
+#pragma once
+
+// Precompiled header of the game-independent core, included first by the plugin's PCH as well
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <optional>
+#include <ranges>
+#include <set>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include <spdlog/spdlog.h>
+
+using namespace std::literals;
+
+namespace Core
+{
+	// Project name, used for the log, cache and report filenames
+	inline constexpr std::string_view NAME = SRD_NAME;
+}
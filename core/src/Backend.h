@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Records.h"
+
+// Everything the loader needs from whatever holds the forms, so that configs can be loaded, validated
+// and benchmarked without the game. Forms are only ever handed back to the backend that returned them.
+class Backend
+{
+public:
+	struct RegionSound
+	{
+		std::uint32_t flags;
+		float chance;
+	};
+
+	virtual ~Backend() = default;
+
+	// Loaded plugins, in load order
+	virtual std::vector<std::string> GetPlugins() = 0;
+	virtual bool IsPluginLoaded(std::string_view a_plugin) = 0;
+	// Changes whenever the load order or a plugin does, cached form lookups are only trusted while it is unchanged
+	virtual std::uint64_t GetLoadOrderHash() = 0;
+
+	// Lookups, GetFormType, IsFormType and GetFormID only read, and may be called from several threads at once while nothing is written
+	virtual Form* LookupForm(std::string_view a_plugin, FormID a_localID) = 0;
+	virtual Form* LookupEditorID(std::string_view a_editorID) = 0;
+	virtual Form* LookupFormID(FormID a_formID) = 0;
+
+	virtual FormType GetFormType(const Form* a_form) = 0;
+	// Whether a_form can be used as a form of a_formType, which includes the types the game derives from it
+	virtual bool IsFormType(const Form* a_form, FormType a_formType) = 0;
+	virtual FormID GetFormID(const Form* a_form) = 0;
+	// EditorID if the form has one, otherwise "800|Plugin.esp"
+	virtual std::string GetIdentifier(const Form* a_form) = 0;
+
+	// a_form is a record of a_category and a_field one of the category's fields
+	virtual Form* GetField(Form* a_form, Records::Category a_category, Field a_field) = 0;
+	virtual void SetField(Form* a_form, Records::Category a_category, Field a_field, Form* a_value) = 0;
+
+	// Regions without sound data cannot be given sounds
+	virtual bool HasRegionSounds(Form* a_region) = 0;
+	virtual std::optional<RegionSound> GetRegionSound(Form* a_region, Form* a_sound) = 0;
+	// Adds the sound to the region if it has none, added sounds may be staged until CommitRegionSounds
+	virtual void SetRegionSound(Form* a_region, Form* a_sound, const RegionSound& a_value) = 0;
+	virtual void CommitRegionSounds() = 0;
+	// Takes back a committed sound that SetRegionSound added, when a reloaded config no longer adds it
+	virtual void RemoveRegionSound(Form* a_region, Form* a_sound) = 0;
+
+	// Shown to the player once loading is done
+	virtual void ShowMessage(const std::string& a_message) = 0;
+};
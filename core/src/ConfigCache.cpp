@@ -0,0 +1,273 @@
+#include "ConfigCache.h"
+
+#include "ConfigFile.h"
+#include "Log.h"
+
+namespace
+{
+	constexpr std::uint32_t CACHE_MAGIC = 0x43445253;  // SRDC
+	constexpr std::uint32_t CACHE_VERSION = 5;
+
+	template <typename T>
+	void Write(std::ostream& a_stream, const T& a_value)
+	{
+		a_stream.write(reinterpret_cast<const char*>(&a_value), sizeof(T));
+	}
+
+	void Write(std::ostream& a_stream, std::string_view a_value)
+	{
+		Write(a_stream, static_cast<std::uint32_t>(a_value.size()));
+		a_stream.write(a_value.data(), a_value.size());
+	}
+
+	template <typename T>
+	bool Read(std::istream& a_stream, T& a_value)
+	{
+		return static_cast<bool>(a_stream.read(reinterpret_cast<char*>(&a_value), sizeof(T)));
+	}
+
+	template <typename C>
+		requires requires(C& a_container) { a_container.data(); a_container.resize(0); }
+	bool Read(std::istream& a_stream, C& a_value)
+	{
+		std::uint32_t size;
+		if (!Read(a_stream, size))
+			return false;
+		a_value.resize(size);
+		return static_cast<bool>(a_stream.read(reinterpret_cast<char*>(a_value.data()), size));
+	}
+}
+
+std::uint64_t ConfigCache::Hash(std::string_view a_data, std::uint64_t a_seed)
+{
+	// FNV-1a
+	std::uint64_t hash = a_seed;
+	for (const auto c : a_data) {
+		hash ^= static_cast<std::uint8_t>(c);
+		hash *= 0x100000001b3;
+	}
+	return hash;
+}
+
+bool ConfigCache::GetFileStamp(const std::string& a_path, FileStamp& a_stamp)
+{
+	return ConfigFile::Stat(a_path, a_stamp);
+}
+
+void ConfigCache::Load(const std::filesystem::path& a_path)
+{
+	std::ifstream stream(a_path, std::ios::binary);
+	if (!stream.good())
+		return;
+
+	std::uint32_t magic, version, configCount, formCount, directoryCount;
+	if (!Read(stream, magic) || magic != CACHE_MAGIC || !Read(stream, version) || version != CACHE_VERSION) {
+		Log::Get(Log::Category::kDiscovery).info("Ignoring incompatible cache {}", a_path.string());
+		return;
+	}
+
+	std::lock_guard lock{ mutex };
+	bool valid = Read(stream, pluginHash) && Read(stream, configCount);
+	for (std::uint32_t i = 0; valid && i < configCount; i++) {
+		std::string path;
+		ConfigEntry entry;
+		valid = Read(stream, path) && Read(stream, entry.stamp) && Read(stream, entry.data);
+		if (valid)
+			configs.emplace(std::move(path), std::move(entry));
+	}
+	valid = valid && Read(stream, formCount);
+	for (std::uint32_t i = 0; valid && i < formCount; i++) {
+		std::string key;
+		FormEntry entry;
+		valid = Read(stream, key) && Read(stream, entry.formID);
+		if (valid)
+			forms.emplace(std::move(key), entry);
+	}
+	valid = valid && Read(stream, directoryCount);
+	for (std::uint32_t i = 0; valid && i < directoryCount; i++) {
+		std::string path;
+		DirectoryEntry entry;
+		std::uint32_t nameCount;
+		valid = Read(stream, path) && Read(stream, entry.time) && Read(stream, nameCount);
+		for (std::uint32_t j = 0; valid && j < nameCount; j++)
+			valid = Read(stream, entry.names.emplace_back());
+		if (valid)
+			directories.emplace(std::move(path), std::move(entry));
+	}
+
+	if (!valid) {
+		Log::Get(Log::Category::kDiscovery).info("Ignoring truncated cache {}", a_path.string());
+		configs.clear();
+		forms.clear();
+		directories.clear();
+		pluginHash = 0;
+		return;
+	}
+	Log::Get(Log::Category::kDiscovery).info("Loaded cache with {} configs and {} forms", configs.size(), forms.size());
+}
+
+void ConfigCache::Save(const std::filesystem::path& a_path)
+{
+	std::lock_guard lock{ mutex };
+	// Entries for configs that were removed, forms that are no longer referenced or directories no longer searched are dropped
+	const auto unused = [](const auto& a_entry) { return !a_entry.second.used; };
+	dirty = dirty || std::ranges::any_of(configs, unused) || std::ranges::any_of(forms, unused) || std::ranges::any_of(directories, unused);
+	if (!dirty)
+		return;
+
+	auto temp = a_path;
+	temp += ".tmp";
+	{
+		std::ofstream stream(temp, std::ios::binary | std::ios::trunc);
+		if (!stream.good()) {
+			Log::Get(Log::Category::kDiscovery).warn("Failed to write cache {}", temp.string());
+			return;
+		}
+
+		Write(stream, CACHE_MAGIC);
+		Write(stream, CACHE_VERSION);
+		Write(stream, pluginHash);
+		Write(stream, static_cast<std::uint32_t>(std::ranges::count_if(configs, [](const auto& a_entry) { return a_entry.second.used; })));
+		for (const auto& [path, entry] : configs) {
+			if (entry.used) {
+				Write(stream, std::string_view{ path });
+				Write(stream, entry.stamp);
+				Write(stream, std::string_view{ reinterpret_cast<const char*>(entry.data.data()), entry.data.size() });
+			}
+		}
+		Write(stream, static_cast<std::uint32_t>(std::ranges::count_if(forms, [](const auto& a_entry) { return a_entry.second.used; })));
+		for (const auto& [key, entry] : forms) {
+			if (entry.used) {
+				Write(stream, std::string_view{ key });
+				Write(stream, entry.formID);
+			}
+		}
+		Write(stream, static_cast<std::uint32_t>(std::ranges::count_if(directories, [](const auto& a_entry) { return a_entry.second.used; })));
+		for (const auto& [path, entry] : directories) {
+			if (entry.used) {
+				Write(stream, std::string_view{ path });
+				Write(stream, entry.time);
+				Write(stream, static_cast<std::uint32_t>(entry.names.size()));
+				for (const auto& name : entry.names)
+					Write(stream, std::string_view{ name });
+			}
+		}
+	}
+
+	std::error_code ec;
+	std::filesystem::rename(temp, a_path, ec);
+	if (ec) {
+		Log::Get(Log::Category::kDiscovery).warn("Failed to write cache {}\n{}", a_path.string(), ec.message());
+		return;
+	}
+	dirty = false;
+}
+
+bool ConfigCache::FindConfig(const std::string& a_path, FileStamp& a_stamp, ConfigData& a_data)
+{
+	const std::vector<std::uint8_t>* data = nullptr;
+	{
+		std::lock_guard lock{ mutex };
+		auto it = configs.find(a_path);
+		if (it == configs.end() || it->second.stamp.size != a_stamp.size || it->second.stamp.time != a_stamp.time)
+			return false;
+		a_stamp.hash = it->second.stamp.hash;
+		it->second.used = true;
+		data = &it->second.data;
+	}
+	return Decode(*data, a_data);
+}
+
+bool ConfigCache::FindConfigByHash(const std::string& a_path, const FileStamp& a_stamp, ConfigData& a_data)
+{
+	const std::vector<std::uint8_t>* data = nullptr;
+	{
+		std::lock_guard lock{ mutex };
+		auto it = configs.find(a_path);
+		if (it == configs.end() || it->second.stamp.size != a_stamp.size || it->second.stamp.hash != a_stamp.hash)
+			return false;
+		// Touched but unchanged, remember the new time so the next launch can skip reading it
+		it->second.stamp.time = a_stamp.time;
+		it->second.used = true;
+		dirty = true;
+		data = &it->second.data;
+	}
+	return Decode(*data, a_data);
+}
+
+bool ConfigCache::Decode(const std::vector<std::uint8_t>& a_buffer, ConfigData& a_data)
+{
+	if (a_data.Deserialize(a_buffer))
+		return true;
+	Log::Get(Log::Category::kParse).warn("Discarding corrupt cache entry");
+	return false;
+}
+
+void ConfigCache::StoreConfig(const std::string& a_path, const FileStamp& a_stamp, const ConfigData& a_data)
+{
+	std::vector<std::uint8_t> data;
+	a_data.Serialize(data);
+	std::lock_guard lock{ mutex };
+	configs[a_path] = { a_stamp, std::move(data), true };
+	dirty = true;
+}
+
+bool ConfigCache::FindDirectory(const std::string& a_path, std::int64_t a_time, std::vector<std::string>& a_names)
+{
+	std::lock_guard lock{ mutex };
+	auto it = directories.find(a_path);
+	if (it == directories.end() || it->second.time != a_time)
+		return false;
+	it->second.used = true;
+	a_names = it->second.names;
+	return true;
+}
+
+void ConfigCache::StoreDirectory(const std::string& a_path, std::int64_t a_time, std::vector<std::string> a_names)
+{
+	std::lock_guard lock{ mutex };
+	directories[a_path] = { a_time, std::move(a_names), true };
+	dirty = true;
+}
+
+void ConfigCache::SetPluginHash(std::uint64_t a_hash)
+{
+	std::lock_guard lock{ mutex };
+	if (pluginHash != a_hash) {
+		if (!forms.empty())
+			Log::Get(Log::Category::kResolve).info("Load order changed, discarding {} cached forms", forms.size());
+		forms.clear();
+		pluginHash = a_hash;
+		dirty = true;
+	}
+}
+
+std::string ConfigCache::GetFormKey(std::string_view a_identifier, std::uint8_t a_formType)
+{
+	std::string key;
+	key.reserve(a_identifier.size() + 1);
+	key.push_back(static_cast<char>(a_formType));
+	key.append(a_identifier);
+	return key;
+}
+
+std::optional<std::uint32_t> ConfigCache::FindForm(std::string_view a_identifier, std::uint8_t a_formType)
+{
+	std::lock_guard lock{ mutex };
+	auto it = forms.find(GetFormKey(a_identifier, a_formType));
+	if (it == forms.end())
+		return std::nullopt;
+	it->second.used = true;
+	return it->second.formID;
+}
+
+void ConfigCache::StoreForm(std::string_view a_identifier, std::uint8_t a_formType, std::uint32_t a_formID)
+{
+	std::lock_guard lock{ mutex };
+	auto& entry = forms[GetFormKey(a_identifier, a_formType)];
+	if (entry.formID != a_formID) {
+		entry.formID = a_formID;
+		dirty = true;
+	}
+	entry.used = true;
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include "ConfigData.h"
+
+// On-disk cache of parsed configs, resolved form identifiers and the configs found in each searched directory.
+// Configs are keyed by path and validated by size, modification time and content hash,
+// resolved forms are only trusted while the hash of the loaded plugin list is unchanged,
+// and a directory's configs only while its modification time is.
+class ConfigCache
+{
+public:
+	struct FileStamp
+	{
+		std::uint64_t size = 0;
+		std::int64_t time = 0;
+		std::uint64_t hash = 0;
+	};
+
+	static std::uint64_t Hash(std::string_view a_data, std::uint64_t a_seed = 0xcbf29ce484222325);
+	static bool GetFileStamp(const std::string& a_path, FileStamp& a_stamp);
+
+	void Load(const std::filesystem::path& a_path);
+	void Save(const std::filesystem::path& a_path);
+
+	// Matches on size and time only, and fills in the hash the entry was stored with
+	bool FindConfig(const std::string& a_path, FileStamp& a_stamp, ConfigData& a_data);
+	bool FindConfigByHash(const std::string& a_path, const FileStamp& a_stamp, ConfigData& a_data);
+	void StoreConfig(const std::string& a_path, const FileStamp& a_stamp, const ConfigData& a_data);
+
+	bool FindDirectory(const std::string& a_path, std::int64_t a_time, std::vector<std::string>& a_names);
+	void StoreDirectory(const std::string& a_path, std::int64_t a_time, std::vector<std::string> a_names);
+
+	void SetPluginHash(std::uint64_t a_hash);
+	std::optional<std::uint32_t> FindForm(std::string_view a_identifier, std::uint8_t a_formType);
+	void StoreForm(std::string_view a_identifier, std::uint8_t a_formType, std::uint32_t a_formID);
+
+private:
+	struct ConfigEntry
+	{
+		FileStamp stamp;
+		std::vector<std::uint8_t> data;
+		bool used = false;
+	};
+
+	struct DirectoryEntry
+	{
+		std::int64_t time = 0;
+		// Filenames of the configs directly inside the directory
+		std::vector<std::string> names;
+		bool used = false;
+	};
+
+	struct FormEntry
+	{
+		std::uint32_t formID = 0;
+		bool used = false;
+	};
+
+	static bool Decode(const std::vector<std::uint8_t>& a_buffer, ConfigData& a_data);
+	static std::string GetFormKey(std::string_view a_identifier, std::uint8_t a_formType);
+
+	std::mutex mutex;
+	std::unordered_map<std::string, ConfigEntry> configs;
+	std::unordered_map<std::string, FormEntry> forms;
+	std::unordered_map<std::string, DirectoryEntry> directories;
+	std::uint64_t pluginHash = 0;
+	bool dirty = false;
+};
@@ -0,0 +1,136 @@
+#include "ConfigData.h"
+
+namespace
+{
+	template <typename T>
+	void Write(std::vector<std::uint8_t>& a_buffer, std::span<const T> a_values)
+	{
+		const auto count = static_cast<std::uint32_t>(a_values.size());
+		const auto offset = a_buffer.size();
+		a_buffer.resize(offset + sizeof(count) + a_values.size_bytes());
+		std::memcpy(a_buffer.data() + offset, &count, sizeof(count));
+		if (!a_values.empty())
+			std::memcpy(a_buffer.data() + offset + sizeof(count), a_values.data(), a_values.size_bytes());
+	}
+
+	template <typename C>
+	bool Read(std::span<const std::uint8_t>& a_buffer, C& a_values)
+	{
+		using T = typename C::value_type;
+		std::uint32_t count;
+		if (a_buffer.size() < sizeof(count))
+			return false;
+		std::memcpy(&count, a_buffer.data(), sizeof(count));
+		a_buffer = a_buffer.subspan(sizeof(count));
+		if (a_buffer.size() / sizeof(T) < count)
+			return false;
+		a_values.resize(count);
+		if (count)
+			std::memcpy(a_values.data(), a_buffer.data(), count * sizeof(T));
+		a_buffer = a_buffer.subspan(count * sizeof(T));
+		return true;
+	}
+}
+
+std::uint32_t ConfigData::AddString(std::string_view a_string)
+{
+	strings.push_back({ static_cast<std::uint32_t>(pool.size()), static_cast<std::uint32_t>(a_string.size()) });
+	pool.append(a_string);
+	return static_cast<std::uint32_t>(strings.size() - 1);
+}
+
+void ConfigData::AddRequirement(std::uint32_t a_string)
+{
+	requirements.push_back(a_string);
+}
+
+std::size_t ConfigData::BeginRequirementGroup(RequirementGroup a_group)
+{
+	requirements.push_back(GROUP_FLAG | std::to_underlying(a_group) << GROUP_SHIFT);
+	return requirements.size() - 1;
+}
+
+void ConfigData::EndRequirementGroup(std::size_t a_header)
+{
+	requirements[a_header] |= static_cast<std::uint32_t>(requirements.size() - a_header - 1) & GROUP_SIZE_MASK;
+}
+
+void ConfigData::AddRecord(Records::Category a_category, std::uint32_t a_form, std::span<const Value> a_values)
+{
+	records[std::to_underlying(a_category)].push_back({ a_form, static_cast<std::uint32_t>(values.size()), static_cast<std::uint32_t>(a_values.size()) });
+	values.insert(values.end(), a_values.begin(), a_values.end());
+}
+
+std::optional<std::string_view> ConfigData::GetString(std::uint32_t a_string) const
+{
+	if (a_string >= strings.size())
+		return std::nullopt;
+	const auto& string = strings[a_string];
+	return std::string_view{ pool }.substr(string.offset, string.size);
+}
+
+std::size_t ConfigData::GetRecordCount() const
+{
+	std::size_t count = 0;
+	for (const auto& category : records)
+		count += category.size();
+	return count;
+}
+
+std::size_t ConfigData::GetMemoryUsage() const
+{
+	std::size_t size = sizeof(*this) + pool.capacity() + strings.capacity() * sizeof(StringRef) + requirements.capacity() * sizeof(std::uint32_t) + values.capacity() * sizeof(Value);
+	for (const auto& category : records)
+		size += category.capacity() * sizeof(Record);
+	return size;
+}
+
+void ConfigData::Serialize(std::vector<std::uint8_t>& a_buffer) const
+{
+	a_buffer.clear();
+	Write(a_buffer, std::span<const char>{ pool });
+	Write(a_buffer, std::span<const StringRef>{ strings });
+	Write(a_buffer, std::span<const std::uint32_t>{ requirements });
+	for (const auto& category : records)
+		Write(a_buffer, std::span<const Record>{ category });
+	Write(a_buffer, std::span<const Value>{ values });
+}
+
+bool ConfigData::Deserialize(std::span<const std::uint8_t> a_buffer)
+{
+	bool valid = Read(a_buffer, pool) && Read(a_buffer, strings) && Read(a_buffer, requirements);
+	for (auto& category : records)
+		valid = valid && Read(a_buffer, category);
+	valid = valid && Read(a_buffer, values) && a_buffer.empty();
+
+	const auto isString = [&](std::uint32_t a_string) { return a_string == NONE || a_string < strings.size(); };
+	valid = valid && std::ranges::all_of(strings, [&](const StringRef& a_string) { return a_string.offset <= pool.size() && a_string.size <= pool.size() - a_string.offset; });
+	// Every group must be of a known kind and end within the group that holds it
+	std::vector<std::size_t> groupEnds{ requirements.size() };
+	for (std::size_t i = 0; valid && i < requirements.size(); i++) {
+		while (groupEnds.back() == i)
+			groupEnds.pop_back();
+		const auto entry = requirements[i];
+		if (!IsRequirementGroup(entry)) {
+			valid = entry < strings.size();
+			continue;
+		}
+		const auto end = i + 1 + GetRequirementGroupSize(entry);
+		valid = GetRequirementGroup(entry) <= RequirementGroup::kNone && end <= groupEnds.back();
+		groupEnds.push_back(end);
+	}
+	for (const auto& category : records) {
+		valid = valid && std::ranges::all_of(category, [&](const Record& a_record) {
+			return isString(a_record.form) && a_record.firstValue <= values.size() && a_record.valueCount <= values.size() - a_record.firstValue;
+		});
+	}
+	valid = valid && std::ranges::all_of(values, [&](const Value& a_value) {
+		if (a_value.field >= Field::kTotal)
+			return false;
+		return a_value.field == Field::kFlags || a_value.field == Field::kChance || isString(a_value.data);
+	});
+
+	if (!valid)
+		*this = {};
+	return valid;
+}
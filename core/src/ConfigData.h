@@ -0,0 +1,75 @@
+#pragma once
+
+#include "Records.h"
+
+// Compact parsed form of a config. Records and their values live in flat arrays
+// and strings in a shared pool, referenced by index. AddString appends as given,
+// ConfigBuilder interns what it parses so that each distinct string is added once.
+class ConfigData
+{
+public:
+	// Index used for a missing string or an explicit null
+	static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+	struct Value
+	{
+		Field field;
+		// A string index for form fields, a flag mask for kFlags and the bits of a float for kChance
+		std::uint32_t data;
+	};
+
+	// Requirements are kept in prefix order: a plugin name as its string index, with a trailing ! if it must be absent,
+	// and a group as a header holding its kind and the number of entries after it that belong to it
+	enum class RequirementGroup : std::uint32_t
+	{
+		kAll,
+		kAny,
+		kNone
+	};
+
+	static constexpr std::uint32_t GROUP_FLAG = 1u << 31;
+	static constexpr std::uint32_t GROUP_SHIFT = 29;
+	static constexpr std::uint32_t GROUP_SIZE_MASK = (1u << GROUP_SHIFT) - 1;
+
+	static bool IsRequirementGroup(std::uint32_t a_entry) { return (a_entry & GROUP_FLAG) != 0; }
+	static RequirementGroup GetRequirementGroup(std::uint32_t a_entry) { return static_cast<RequirementGroup>((a_entry & ~GROUP_FLAG) >> GROUP_SHIFT); }
+	static std::uint32_t GetRequirementGroupSize(std::uint32_t a_entry) { return a_entry & GROUP_SIZE_MASK; }
+
+	struct Record
+	{
+		std::uint32_t form = NONE;
+		std::uint32_t firstValue = 0;
+		std::uint32_t valueCount = 0;
+	};
+
+	std::uint32_t AddString(std::string_view a_string);
+	void AddRequirement(std::uint32_t a_string);
+	// Returns the position of the group's header, to be closed once its entries have been added
+	std::size_t BeginRequirementGroup(RequirementGroup a_group);
+	void EndRequirementGroup(std::size_t a_header);
+	void AddRecord(Records::Category a_category, std::uint32_t a_form, std::span<const Value> a_values);
+
+	std::optional<std::string_view> GetString(std::uint32_t a_string) const;
+	std::span<const std::uint32_t> GetRequirements() const { return requirements; }
+	std::span<const Record> GetRecords(Records::Category a_category) const { return records[std::to_underlying(a_category)]; }
+	std::span<const Value> GetValues(const Record& a_record) const { return std::span{ values }.subspan(a_record.firstValue, a_record.valueCount); }
+	std::size_t GetRecordCount() const;
+	std::size_t GetMemoryUsage() const;
+
+	void Serialize(std::vector<std::uint8_t>& a_buffer) const;
+	// Validates every index so that a corrupt buffer is rejected instead of read out of bounds
+	bool Deserialize(std::span<const std::uint8_t> a_buffer);
+
+private:
+	struct StringRef
+	{
+		std::uint32_t offset;
+		std::uint32_t size;
+	};
+
+	std::string pool;
+	std::vector<StringRef> strings;
+	std::vector<std::uint32_t> requirements;
+	std::array<std::vector<Record>, std::to_underlying(Records::Category::kTotal)> records;
+	std::vector<Value> values;
+};
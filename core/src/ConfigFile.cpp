@@ -0,0 +1,117 @@
+#include "ConfigFile.h"
+
+#ifdef _WIN32
+#	define WIN32_LEAN_AND_MEAN
+#	define NOMINMAX
+#	include <Windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace
+{
+#ifdef _WIN32
+	// FILETIME counts the same 100ns ticks since 1601 as std::filesystem::file_time_type, so stamps stay comparable with older caches
+	std::int64_t ToTime(const FILETIME& a_time)
+	{
+		return static_cast<std::int64_t>((static_cast<std::uint64_t>(a_time.dwHighDateTime) << 32) | a_time.dwLowDateTime);
+	}
+
+	std::uint64_t ToSize(DWORD a_high, DWORD a_low)
+	{
+		return (static_cast<std::uint64_t>(a_high) << 32) | a_low;
+	}
+#else
+	std::int64_t ToTime(const struct timespec& a_time)
+	{
+		return static_cast<std::int64_t>(a_time.tv_sec) * 1'000'000'000 + a_time.tv_nsec;
+	}
+#endif
+}
+
+ConfigFile::ConfigFile(const std::string& a_path)
+{
+#ifdef _WIN32
+	const auto file = CreateFileW(std::filesystem::path(a_path).c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return;
+	BY_HANDLE_FILE_INFORMATION info;
+	if (!GetFileInformationByHandle(file, &info)) {
+		CloseHandle(file);
+		return;
+	}
+	handle = reinterpret_cast<std::intptr_t>(file);
+	stamp.size = ToSize(info.nFileSizeHigh, info.nFileSizeLow);
+	stamp.time = ToTime(info.ftLastWriteTime);
+#else
+	const int file = open(a_path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (file < 0)
+		return;
+	struct stat info;
+	if (fstat(file, &info) != 0) {
+		close(file);
+		return;
+	}
+	handle = file;
+	stamp.size = static_cast<std::uint64_t>(info.st_size);
+	stamp.time = ToTime(info.st_mtim);
+#endif
+}
+
+ConfigFile::~ConfigFile()
+{
+	if (!IsOpen())
+		return;
+#ifdef _WIN32
+	CloseHandle(reinterpret_cast<HANDLE>(handle));
+#else
+	close(static_cast<int>(handle));
+#endif
+}
+
+bool ConfigFile::Read(std::string& a_buffer)
+{
+	if (!IsOpen())
+		return false;
+
+	a_buffer.resize(static_cast<std::size_t>(stamp.size));
+	std::size_t offset = 0;
+	while (offset < a_buffer.size()) {
+#ifdef _WIN32
+		DWORD count = 0;
+		const auto request = static_cast<DWORD>(std::min<std::size_t>(a_buffer.size() - offset, std::numeric_limits<DWORD>::max()));
+		if (!ReadFile(reinterpret_cast<HANDLE>(handle), a_buffer.data() + offset, request, &count, nullptr))
+			return false;
+#else
+		const auto count = read(static_cast<int>(handle), a_buffer.data() + offset, a_buffer.size() - offset);
+		if (count < 0)
+			return false;
+#endif
+		// Shrunk since it was opened
+		if (count == 0)
+			break;
+		offset += static_cast<std::size_t>(count);
+	}
+	a_buffer.resize(offset);
+	return true;
+}
+
+bool ConfigFile::Stat(const std::string& a_path, ConfigCache::FileStamp& a_stamp)
+{
+#ifdef _WIN32
+	WIN32_FILE_ATTRIBUTE_DATA info;
+	if (!GetFileAttributesExW(std::filesystem::path(a_path).c_str(), GetFileExInfoStandard, &info))
+		return false;
+	a_stamp.size = ToSize(info.nFileSizeHigh, info.nFileSizeLow);
+	a_stamp.time = ToTime(info.ftLastWriteTime);
+#else
+	struct stat info;
+	if (stat(a_path.c_str(), &info) != 0)
+		return false;
+	a_stamp.size = static_cast<std::uint64_t>(info.st_size);
+	a_stamp.time = ToTime(info.st_mtim);
+#endif
+	return true;
+}
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "ConfigCache.h"
+
+// A config opened once: its stamp comes from the open handle and its contents from a single sized read,
+// so that a file costs one path lookup whether or not the cache already holds it
+class ConfigFile
+{
+public:
+	explicit ConfigFile(const std::string& a_path);
+	~ConfigFile();
+
+	ConfigFile(const ConfigFile&) = delete;
+	ConfigFile& operator=(const ConfigFile&) = delete;
+
+	bool IsOpen() const { return handle != INVALID; }
+	// Size and modification time of the open file, the hash is left at zero
+	const ConfigCache::FileStamp& GetStamp() const { return stamp; }
+
+	// Reads the whole file into a_buffer, reusing its capacity
+	bool Read(std::string& a_buffer);
+
+	// Size and modification time with a single query of the path, without opening the file
+	static bool Stat(const std::string& a_path, ConfigCache::FileStamp& a_stamp);
+
+private:
+	static constexpr std::intptr_t INVALID = -1;
+
+	std::intptr_t handle = INVALID;
+	ConfigCache::FileStamp stamp;
+};
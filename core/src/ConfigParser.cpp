@@ -0,0 +1,496 @@
+#include "ConfigParser.h"
+
+#include <spanstream>
+#include <yaml-cpp/eventhandler.h>
+#include <yaml-cpp/parser.h>
+
+#include "tojson.hpp"
+
+bool ConfigBuilder::null()
+{
+	return scalar({ .null = true });
+}
+
+bool ConfigBuilder::boolean(bool)
+{
+	return scalar({});
+}
+
+bool ConfigBuilder::number_integer(json::number_integer_t a_value)
+{
+	return scalar({ .number = static_cast<double>(a_value) });
+}
+
+bool ConfigBuilder::number_unsigned(json::number_unsigned_t a_value)
+{
+	return scalar({ .number = static_cast<double>(a_value) });
+}
+
+bool ConfigBuilder::number_float(json::number_float_t a_value, const json::string_t&)
+{
+	return scalar({ .number = a_value });
+}
+
+bool ConfigBuilder::string(json::string_t& a_value)
+{
+	return scalar({ .string = a_value });
+}
+
+bool ConfigBuilder::binary(json::binary_t&)
+{
+	return scalar({});
+}
+
+bool ConfigBuilder::start_object(std::size_t)
+{
+	return OnStart(true);
+}
+
+bool ConfigBuilder::end_object()
+{
+	return OnEnd();
+}
+
+bool ConfigBuilder::start_array(std::size_t)
+{
+	return OnStart(false);
+}
+
+bool ConfigBuilder::end_array()
+{
+	return OnEnd();
+}
+
+bool ConfigBuilder::parse_error(std::size_t, const std::string&, const json::exception& a_exception)
+{
+	throw std::runtime_error(a_exception.what());
+}
+
+bool ConfigBuilder::key(json::string_t& a_key)
+{
+	if (skipDepth)
+		return true;
+
+	currentKey = a_key;
+	currentField.reset();
+	switch (stack.back()) {
+	case Context::kDocument:
+		if (a_key == "Requirements") {
+			category = Records::Category::kTotal;
+		} else if (const auto found = Records::FindCategory(a_key)) {
+			category = *found;
+		} else {
+			skipValue = true;
+		}
+		break;
+	case Context::kRequirementGroup:
+		if (requirementGroups.back())
+			Fail("a single group");
+		if (a_key == "All")
+			requirementGroup = ConfigData::RequirementGroup::kAll;
+		else if (a_key == "Any")
+			requirementGroup = ConfigData::RequirementGroup::kAny;
+		else if (a_key == "None")
+			requirementGroup = ConfigData::RequirementGroup::kNone;
+		else
+			Fail("All, Any or None");
+		break;
+	case Context::kRecord:
+		if (a_key == "Form")
+			break;
+		if (category == Records::Category::kRegions) {
+			skipValue = a_key != "RDSA";
+		} else if (const auto field = Records::FindCategoryField(category, a_key)) {
+			currentField = field;
+		} else {
+			skipValue = true;
+		}
+		break;
+	case Context::kRegionSound:
+		if (const auto field = Records::FindCategoryField(Records::Category::kRegions, a_key))
+			currentField = field;
+		else
+			skipValue = true;
+		break;
+	default:
+		break;
+	}
+	return true;
+}
+
+bool ConfigBuilder::scalar(const Scalar& a_value)
+{
+	if (skipDepth)
+		return true;
+	if (skipValue) {
+		skipValue = false;
+		return true;
+	}
+	if (stack.empty())
+		Fail("an object");
+
+	switch (stack.back()) {
+	case Context::kDocument:
+		Fail("an array");
+	case Context::kRequirements:
+		if (!a_value.string)
+			Fail("a plugin name");
+		data.AddRequirement(Intern(*a_value.string));
+		break;
+	case Context::kRequirementGroup:
+		Fail("a list of requirements");
+	case Context::kCategory:
+	case Context::kRegionSounds:
+		Fail("an object");
+	case Context::kRecord:
+		if (currentKey != "Form" && !currentField)
+			Fail("an array");
+		if (!a_value.string && !a_value.null)
+			Fail("a form identifier");
+		if (currentField)
+			values.push_back({ *currentField, a_value.string ? Intern(*a_value.string) : ConfigData::NONE });
+		else
+			form = a_value.string ? Intern(*a_value.string) : ConfigData::NONE;
+		break;
+	case Context::kRegionSound:
+		switch (*currentField) {
+		case Field::kSound:
+			if (!a_value.string && !a_value.null)
+				Fail("a form identifier");
+			regionSound = a_value.string ? Intern(*a_value.string) : ConfigData::NONE;
+			break;
+		case Field::kFlags:
+			if (!a_value.string)
+				Fail("a list of flags");
+			regionFlags = ConfigParser::GetSoundFlags(*a_value.string);
+			break;
+		case Field::kChance:
+			if (!a_value.number)
+				Fail("a number");
+			regionChance = static_cast<float>(*a_value.number);
+			break;
+		default:
+			break;
+		}
+		break;
+	}
+	return true;
+}
+
+bool ConfigBuilder::OnStart(bool a_object)
+{
+	if (skipDepth) {
+		skipDepth++;
+		return true;
+	}
+	if (skipValue) {
+		skipValue = false;
+		skipDepth = 1;
+		return true;
+	}
+	if (stack.empty()) {
+		if (!a_object)
+			Fail("an object");
+		stack.push_back(Context::kDocument);
+		return true;
+	}
+
+	switch (stack.back()) {
+	case Context::kDocument:
+		if (a_object)
+			Fail("an array");
+		stack.push_back(category == Records::Category::kTotal ? Context::kRequirements : Context::kCategory);
+		break;
+	case Context::kRequirements:
+		if (!a_object)
+			Fail("a plugin name or a group");
+		requirementGroups.emplace_back();
+		stack.push_back(Context::kRequirementGroup);
+		break;
+	case Context::kRequirementGroup:
+		if (a_object || !requirementGroup)
+			Fail("a list of requirements");
+		requirementGroups.back() = data.BeginRequirementGroup(*requirementGroup);
+		requirementGroup.reset();
+		stack.push_back(Context::kRequirements);
+		break;
+	case Context::kCategory:
+		if (!a_object)
+			Fail("an object");
+		form = ConfigData::NONE;
+		values.clear();
+		stack.push_back(Context::kRecord);
+		break;
+	case Context::kRecord:
+		if (a_object || currentField || currentKey == "Form")
+			Fail("a form identifier");
+		stack.push_back(Context::kRegionSounds);
+		break;
+	case Context::kRegionSounds:
+		if (!a_object)
+			Fail("an object");
+		regionSound.reset();
+		regionFlags.reset();
+		regionChance.reset();
+		stack.push_back(Context::kRegionSound);
+		break;
+	case Context::kRegionSound:
+		Fail("a single value");
+	}
+	return true;
+}
+
+bool ConfigBuilder::OnEnd()
+{
+	if (skipDepth) {
+		skipDepth--;
+		return true;
+	}
+
+	const auto context = stack.back();
+	stack.pop_back();
+	switch (context) {
+	case Context::kRequirements:
+		if (stack.back() == Context::kRequirementGroup)
+			data.EndRequirementGroup(*requirementGroups.back());
+		break;
+	case Context::kRequirementGroup:
+		if (!requirementGroups.back())
+			Fail("All, Any or None");
+		requirementGroups.pop_back();
+		break;
+	case Context::kRecord:
+		data.AddRecord(category, form, values);
+		break;
+	case Context::kRegionSound:
+		// Entries without a sound were ignored before, there is nothing to key them on
+		if (regionSound) {
+			values.push_back({ Field::kSound, *regionSound });
+			if (regionFlags)
+				values.push_back({ Field::kFlags, *regionFlags });
+			if (regionChance)
+				values.push_back({ Field::kChance, std::bit_cast<std::uint32_t>(*regionChance) });
+		}
+		break;
+	default:
+		break;
+	}
+	return true;
+}
+
+std::uint32_t ConfigBuilder::Intern(std::string_view a_string)
+{
+	if (const auto it = interned.find(a_string); it != interned.end())
+		return it->second;
+	const auto index = data.AddString(a_string);
+	interned.emplace(a_string, index);
+	return index;
+}
+
+void ConfigBuilder::Fail(std::string_view a_expected) const
+{
+	if (category != Records::Category::kTotal && stack.size() > 1)
+		throw std::invalid_argument(std::format("Expected {} for \"{}\" in {}", a_expected, currentKey, Records::CATEGORY_NAMES[std::to_underlying(category)]));
+	throw std::invalid_argument(std::format("Expected {} for \"{}\"", a_expected, currentKey));
+}
+
+namespace
+{
+	// Translates yaml-cpp events into builder calls, map entries arrive as alternating key and value events
+	class YAMLHandler : public YAML::EventHandler
+	{
+	public:
+		struct UnsupportedAlias
+		{};
+
+		explicit YAMLHandler(ConfigBuilder& a_builder) :
+			builder(a_builder) {}
+
+		void OnDocumentStart(const YAML::Mark&) override {}
+		void OnDocumentEnd() override {}
+
+		void OnNull(const YAML::Mark&, YAML::anchor_t) override
+		{
+			if (IsKey())
+				return Key({});
+			builder.null();
+			EndValue();
+		}
+
+		void OnAlias(const YAML::Mark&, YAML::anchor_t) override
+		{
+			throw UnsupportedAlias{};
+		}
+
+		void OnScalar(const YAML::Mark&, const std::string& a_tag, YAML::anchor_t, const std::string& a_value) override
+		{
+			if (IsKey())
+				return Key(a_value);
+
+			// Only plain scalars are typed, quoted ones are always strings
+			ConfigBuilder::Scalar value{ .string = a_value };
+			if (a_tag == "?") {
+				if (a_value.empty() || a_value == "~" || a_value == "null" || a_value == "Null" || a_value == "NULL") {
+					value = { .null = true };
+				} else {
+					double number;
+					const auto end = a_value.data() + a_value.size();
+					if (const auto [ptr, ec] = std::from_chars(a_value.data(), end, number); ec == std::errc{} && ptr == end)
+						value.number = number;
+				}
+			}
+			builder.scalar(value);
+			EndValue();
+		}
+
+		void OnSequenceStart(const YAML::Mark&, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value) override
+		{
+			if (IsKey())
+				throw std::invalid_argument("Complex keys are not supported");
+			builder.start_array(0);
+			frames.push_back({ false, false });
+		}
+
+		void OnSequenceEnd() override
+		{
+			frames.pop_back();
+			builder.end_array();
+			EndValue();
+		}
+
+		void OnMapStart(const YAML::Mark&, const std::string&, YAML::anchor_t, YAML::EmitterStyle::value) override
+		{
+			if (IsKey())
+				throw std::invalid_argument("Complex keys are not supported");
+			builder.start_object(0);
+			frames.push_back({ true, true });
+		}
+
+		void OnMapEnd() override
+		{
+			frames.pop_back();
+			builder.end_object();
+			EndValue();
+		}
+
+	private:
+		struct Frame
+		{
+			bool map;
+			bool key;
+		};
+
+		bool IsKey() const
+		{
+			return !frames.empty() && frames.back().map && frames.back().key;
+		}
+
+		void Key(const std::string& a_key)
+		{
+			frames.back().key = false;
+			json::string_t key = a_key;
+			builder.key(key);
+		}
+
+		void EndValue()
+		{
+			if (!frames.empty() && frames.back().map)
+				frames.back().key = true;
+		}
+
+		ConfigBuilder& builder;
+		std::vector<Frame> frames;
+	};
+
+	void Replay(const json& a_value, ConfigBuilder& a_builder)
+	{
+		switch (a_value.type()) {
+		case json::value_t::object:
+			a_builder.start_object(a_value.size());
+			for (const auto& [key, value] : a_value.items()) {
+				json::string_t name = key;
+				a_builder.key(name);
+				Replay(value, a_builder);
+			}
+			a_builder.end_object();
+			break;
+		case json::value_t::array:
+			a_builder.start_array(a_value.size());
+			for (const auto& value : a_value)
+				Replay(value, a_builder);
+			a_builder.end_array();
+			break;
+		case json::value_t::string:
+			{
+				auto string = a_value.get<json::string_t>();
+				a_builder.string(string);
+			}
+			break;
+		case json::value_t::boolean:
+			a_builder.boolean(a_value.get<bool>());
+			break;
+		case json::value_t::number_integer:
+			a_builder.number_integer(a_value.get<json::number_integer_t>());
+			break;
+		case json::value_t::number_unsigned:
+			a_builder.number_unsigned(a_value.get<json::number_unsigned_t>());
+			break;
+		case json::value_t::number_float:
+			a_builder.number_float(a_value.get<json::number_float_t>(), {});
+			break;
+		default:
+			a_builder.null();
+			break;
+		}
+	}
+}
+
+void ConfigParser::ParseJSON(std::string_view a_buffer, ConfigData& a_data)
+{
+	ConfigBuilder builder{ a_data };
+	json::sax_parse(a_buffer.begin(), a_buffer.end(), &builder, json::input_format_t::json, true, true);
+}
+
+void ConfigParser::ParseYAML(std::string_view a_buffer, ConfigData& a_data)
+{
+	try {
+		ConfigBuilder builder{ a_data };
+		YAMLHandler handler{ builder };
+		std::ispanstream stream{ a_buffer };
+		YAML::Parser parser{ stream };
+		parser.HandleNextDocument(handler);
+	} catch (const YAMLHandler::UnsupportedAlias&) {
+		// Aliases refer back to earlier nodes, so only a full document can resolve them
+		a_data = {};
+		ParseDocument(tojson::yaml2json(std::string{ a_buffer }), a_data);
+	}
+}
+
+void ConfigParser::ParseDocument(const json& a_document, ConfigData& a_data)
+{
+	// An empty document has nothing to apply
+	if (a_document.is_null())
+		return;
+	ConfigBuilder builder{ a_data };
+	Replay(a_document, builder);
+}
+
+std::uint32_t ConfigParser::GetSoundFlags(std::string_view a_flags)
+{
+	using Flag = Records::RegionSoundFlag;
+
+	std::uint32_t flags = std::to_underlying(Flag::kNone);
+	for (const auto word : std::views::split(a_flags, ' ')) {
+		const std::string_view flag{ word.begin(), word.end() };
+		if (flag == "Pleasant") {
+			flags |= std::to_underlying(Flag::kPleasant);
+		} else if (flag == "Cloudy") {
+			flags |= std::to_underlying(Flag::kCloudy);
+		} else if (flag == "Rainy") {
+			flags |= std::to_underlying(Flag::kRainy);
+		} else if (flag == "Snowy") {
+			flags |= std::to_underlying(Flag::kSnowy);
+		}
+	}
+	return flags;
+}
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+#include "ConfigData.h"
+#include "StringUtil.h"
+
+// Receives parser events and builds ConfigData directly, without materializing a document.
+// Implements the nlohmann::json SAX interface, unknown keys are skipped and malformed
+// entries throw with a message naming the category and key.
+class ConfigBuilder
+{
+public:
+	explicit ConfigBuilder(ConfigData& a_data) :
+		data(a_data) {}
+
+	bool null();
+	bool boolean(bool a_value);
+	bool number_integer(json::number_integer_t a_value);
+	bool number_unsigned(json::number_unsigned_t a_value);
+	bool number_float(json::number_float_t a_value, const json::string_t& a_string);
+	bool string(json::string_t& a_value);
+	bool binary(json::binary_t& a_value);
+	bool start_object(std::size_t a_size);
+	bool key(json::string_t& a_key);
+	bool end_object();
+	bool start_array(std::size_t a_size);
+	bool end_array();
+	bool parse_error(std::size_t a_position, const std::string& a_lastToken, const json::exception& a_exception);
+
+	// A scalar from a source without JSON's types, may carry both its text and its numeric value
+	struct Scalar
+	{
+		std::optional<std::string_view> string;
+		std::optional<double> number;
+		bool null = false;
+	};
+
+	bool scalar(const Scalar& a_value);
+
+private:
+	enum class Context
+	{
+		kDocument,
+		kRequirements,
+		kRequirementGroup,
+		kCategory,
+		kRecord,
+		kRegionSounds,
+		kRegionSound
+	};
+
+	bool OnStart(bool a_object);
+	bool OnEnd();
+
+	std::uint32_t Intern(std::string_view a_string);
+	[[noreturn]] void Fail(std::string_view a_expected) const;
+
+	ConfigData& data;
+	// Looked up by view, a key is only allocated for the first occurrence of each string
+	StringUtil::Map<std::uint32_t> interned;
+	std::vector<Context> stack;
+
+	// Key of the value about to be read, and whether that value is skipped entirely
+	std::string currentKey;
+	std::optional<Field> currentField;
+	bool skipValue = false;
+	std::size_t skipDepth = 0;
+
+	Records::Category category = Records::Category::kTotal;
+	std::uint32_t form = ConfigData::NONE;
+	std::vector<ConfigData::Value> values;
+
+	// Header of each requirement group being read, unset until its All, Any or None key has opened its list
+	std::vector<std::optional<std::size_t>> requirementGroups;
+	std::optional<ConfigData::RequirementGroup> requirementGroup;
+
+	// Region sound entries may list their keys in any order, so they are collected before being appended
+	std::optional<std::uint32_t> regionSound;
+	std::optional<std::uint32_t> regionFlags;
+	std::optional<float> regionChance;
+};
+
+namespace ConfigParser
+{
+	// Parses JSON with comments, throws on syntax errors and malformed entries
+	void ParseJSON(std::string_view a_buffer, ConfigData& a_data);
+
+	// Parses YAML from yaml-cpp's event stream without building a node tree or a JSON document
+	void ParseYAML(std::string_view a_buffer, ConfigData& a_data);
+
+	// Replays an existing document through the builder
+	void ParseDocument(const json& a_document, ConfigData& a_data);
+
+	std::uint32_t GetSoundFlags(std::string_view a_flags);
+}
@@ -0,0 +1,223 @@
+#include "ConfigPipeline.h"
+
+#include "ConfigParser.h"
+
+ConfigPipeline::ConfigPipeline(ConfigCache* a_cache, std::size_t a_window) :
+	cache(a_cache),
+	window(a_window ? a_window : std::max(2u, std::thread::hardware_concurrency() * 2))
+{
+}
+
+ConfigPipeline::~ConfigPipeline()
+{
+	// The pool still runs every task it was given before its threads are joined, cancelled ones return at once
+	cancelled = true;
+}
+
+void ConfigPipeline::Push(const std::string& a_path)
+{
+	std::lock_guard lock{ mutex };
+	if (jobs.contains(a_path))
+		return;
+	auto job = std::make_unique<Job>();
+	job->config.path = a_path;
+	job->config.filename = std::filesystem::path(a_path).filename().string();
+	pending.emplace_back(job.get());
+	jobs.emplace(a_path, std::move(job));
+	Dispatch();
+}
+
+void ConfigPipeline::SetOrder(std::span<const std::string> a_order)
+{
+	std::unordered_map<std::string_view, std::size_t> ranks;
+	ranks.reserve(a_order.size());
+	for (std::size_t i = 0; i < a_order.size(); i++)
+		ranks.try_emplace(a_order[i], i);
+
+	std::lock_guard lock{ mutex };
+	std::erase_if(pending, [&](const Job* a_job) {
+		if (ranks.contains(a_job->config.path))
+			return false;
+		jobs.erase(jobs.find(a_job->config.path));
+		return true;
+	});
+	std::ranges::stable_sort(pending, {}, [&](const Job* a_job) { return ranks.find(a_job->config.path)->second; });
+	ordered = true;
+}
+
+ParsedConfig ConfigPipeline::Take(const std::string& a_path)
+{
+	std::unique_lock lock{ mutex };
+	auto it = jobs.find(a_path);
+	if (it == jobs.end()) {
+		lock.unlock();
+		return LoadConfig(a_path);
+	}
+
+	auto job = it->second.get();
+	if (job->state == State::kQueued) {
+		// The consumer is waiting on a file no worker has picked up yet, so do it here instead of queueing behind the window
+		std::erase(pending, job);
+		jobs.erase(it);
+		lock.unlock();
+		return LoadConfig(a_path);
+	}
+
+	finished.wait(lock, [job]() { return job->state == State::kDone; });
+	auto config = std::move(job->config);
+	jobs.erase(a_path);
+	ready--;
+	Dispatch();
+	return config;
+}
+
+void ConfigPipeline::Dispatch()
+{
+	// Nothing is taken before the order is known, so until then finished files are left out of the count
+	while (inflight + (ordered ? ready : 0) < window && !pending.empty()) {
+		auto job = pending.front();
+		pending.pop_front();
+		job->state = State::kReading;
+		inflight++;
+		pool.Submit([this, job]() { Read(job); });
+	}
+}
+
+void ConfigPipeline::Read(Job* a_job)
+{
+	if (cancelled)
+		return;
+	const bool done = ReadStage(*a_job);
+
+	std::lock_guard lock{ mutex };
+	if (cancelled)
+		return;
+	if (done) {
+		// Stays in the window until it is taken
+		a_job->state = State::kDone;
+		inflight--;
+		ready++;
+		finished.notify_all();
+		return;
+	}
+	a_job->state = State::kParsing;
+	pool.Submit([this, a_job]() { Parse(a_job); });
+}
+
+void ConfigPipeline::Parse(Job* a_job)
+{
+	if (cancelled)
+		return;
+	ParseStage(*a_job);
+
+	std::lock_guard lock{ mutex };
+	a_job->state = State::kDone;
+	inflight--;
+	ready++;
+	finished.notify_all();
+}
+
+bool ConfigPipeline::ReadStage(Job& a_job)
+{
+	auto& config = a_job.config;
+	auto begin = std::chrono::steady_clock::now();
+	const auto finish = [&](bool a_cached) {
+		config.cached = a_cached;
+		config.readTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	};
+
+	// The stamp comes from the open file, so a cache hit and a full read both cost a single open
+	ConfigFile file{ config.path };
+	config.openTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	begin = std::chrono::steady_clock::now();
+	config.stamp = file.GetStamp();
+
+	a_job.cacheable = file.IsOpen() && cache;
+	if (a_job.cacheable && cache->FindConfig(config.path, config.stamp, config.data)) {
+		finish(true);
+		return true;
+	}
+
+	a_job.buffer = AcquireBuffer();
+	const bool read = ReadConfig(file, config.filename, a_job.buffer, config.error);
+	config.bytes = a_job.buffer.size();
+	if (!read) {
+		ReleaseBuffer(std::move(a_job.buffer));
+		finish(false);
+		return true;
+	}
+
+	config.stamp.hash = ConfigCache::Hash(a_job.buffer);
+	if (a_job.cacheable && cache->FindConfigByHash(config.path, config.stamp, config.data)) {
+		ReleaseBuffer(std::move(a_job.buffer));
+		finish(true);
+		return true;
+	}
+	finish(false);
+	return false;
+}
+
+void ConfigPipeline::ParseStage(Job& a_job)
+{
+	const auto begin = std::chrono::steady_clock::now();
+	ParseConfig(a_job.config, a_job.buffer);
+	ReleaseBuffer(std::move(a_job.buffer));
+	a_job.config.parseTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - begin).count();
+	if (a_job.cacheable && a_job.config.error.empty())
+		cache->StoreConfig(a_job.config.path, a_job.config.stamp, a_job.config.data);
+}
+
+std::string ConfigPipeline::AcquireBuffer()
+{
+	std::lock_guard lock{ mutex };
+	if (buffers.empty())
+		return {};
+	auto buffer = std::move(buffers.back());
+	buffers.pop_back();
+	return buffer;
+}
+
+void ConfigPipeline::ReleaseBuffer(std::string&& a_buffer)
+{
+	std::lock_guard lock{ mutex };
+	buffers.emplace_back(std::move(a_buffer));
+	a_buffer = {};
+}
+
+bool ConfigPipeline::ReadConfig(ConfigFile& a_file, std::string_view a_filename, std::string& a_buffer, std::string& a_error)
+{
+	if (!a_file.IsOpen()) {
+		a_buffer.clear();
+		a_error = std::format("Failed to parse {}\nBad file stream", a_filename);
+		return false;
+	}
+	if (!a_file.Read(a_buffer)) {
+		a_buffer.clear();
+		a_error = std::format("Failed to parse {}\nCould not read the file", a_filename);
+		return false;
+	}
+	return true;
+}
+
+void ConfigPipeline::ParseConfig(ParsedConfig& a_config, std::string_view a_buffer)
+{
+	try {
+		if (a_config.path.ends_with(".yaml"sv)) {
+			ConfigParser::ParseYAML(a_buffer, a_config.data);
+		} else {
+			ConfigParser::ParseJSON(a_buffer, a_config.data);
+		}
+	} catch (const std::exception& exc) {
+		a_config.error = std::format("Failed to parse {}\n{}", a_config.filename, exc.what());
+	}
+}
+
+ParsedConfig ConfigPipeline::LoadConfig(const std::string& a_path)
+{
+	Job job;
+	job.config.path = a_path;
+	job.config.filename = std::filesystem::path(a_path).filename().string();
+	if (!ReadStage(job))
+		ParseStage(job);
+	return std::move(job.config);
+}
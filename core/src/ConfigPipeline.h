@@ -0,0 +1,101 @@
+#pragma once
+
+#include "ConfigCache.h"
+#include "ConfigData.h"
+#include "ConfigFile.h"
+#include "ThreadPool.h"
+
+struct ParsedConfig
+{
+	std::string path;
+	std::string filename;
+	ConfigData data;
+	std::string error;
+
+	// Set by the loader once it has checked the requirements against the load order, with the entries that do not hold
+	bool requirementsMet = false;
+	std::vector<std::string> missingRequirements;
+
+	// Size, time and content hash of the file that was loaded, the hash is zero if it could not be read
+	ConfigCache::FileStamp stamp;
+
+	// Bytes read from disk, whether the data came from the cache, and milliseconds spent opening, reading and parsing
+	std::uint64_t bytes = 0;
+	bool cached = false;
+	double openTime = 0.0;
+	double readTime = 0.0;
+	double parseTime = 0.0;
+};
+
+// Reads and parses configs on worker threads in the order they are pushed. Until the apply order is set
+// only the files being read or parsed are bounded by the window, so that everything pushed is parsed ahead
+// of time. From then on it is a bounded look-ahead: files in flight and finished files not yet taken together
+// never exceed the window. Results are handed back in whatever order the consumer asks for them, files it
+// asks for before a worker has picked them up are loaded on its own thread.
+class ConfigPipeline
+{
+public:
+	explicit ConfigPipeline(ConfigCache* a_cache = nullptr, std::size_t a_window = 0);
+	// Files the workers have not started on are dropped rather than waited for
+	~ConfigPipeline();
+
+	void Push(const std::string& a_path);
+	// Queued files are dispatched in a_order from now on, those missing from it are dropped since they are never taken
+	void SetOrder(std::span<const std::string> a_order);
+	ParsedConfig Take(const std::string& a_path);
+
+	std::size_t GetWindow() const { return window; }
+	// Other work of the same load runs on these workers as well, rather than starting threads of its own
+	ThreadPool& GetPool() { return pool; }
+
+	// Reads an opened config into a_buffer, reusing its capacity
+	static bool ReadConfig(ConfigFile& a_file, std::string_view a_filename, std::string& a_buffer, std::string& a_error);
+	static void ParseConfig(ParsedConfig& a_config, std::string_view a_buffer);
+	ParsedConfig LoadConfig(const std::string& a_path);
+
+private:
+	enum class State
+	{
+		kQueued,
+		kReading,
+		kParsing,
+		kDone
+	};
+
+	struct Job
+	{
+		ParsedConfig config;
+		std::string buffer;
+		bool cacheable = false;
+		State state = State::kQueued;
+	};
+
+	void Dispatch();
+	void Read(Job* a_job);
+	void Parse(Job* a_job);
+
+	// Returns true when the job finished without needing to be parsed
+	bool ReadStage(Job& a_job);
+	void ParseStage(Job& a_job);
+
+	// Read buffers are handed back once parsed, so that their memory serves the next files
+	std::string AcquireBuffer();
+	void ReleaseBuffer(std::string&& a_buffer);
+
+	ConfigCache* cache;
+
+	std::mutex mutex;
+	std::condition_variable finished;
+	std::unordered_map<std::string, std::unique_ptr<Job>> jobs;
+	std::deque<Job*> pending;
+	std::size_t inflight = 0;
+	// Finished and waiting to be taken, counted against the window once the order is set
+	std::size_t ready = 0;
+	bool ordered = false;
+	std::size_t window;
+	std::atomic<bool> cancelled = false;
+	std::vector<std::string> buffers;
+
+	// Declared last so that workers are joined before the jobs they reference are destroyed
+	ThreadPool pool;
+};
@@ -0,0 +1,60 @@
+#include "ConfigWatcher.h"
+
+#include "ConfigCache.h"
+#include "ConfigFile.h"
+#include "Loader.h"
+
+ConfigWatcher::ConfigWatcher(std::vector<std::filesystem::path> a_directories, std::chrono::milliseconds a_interval, std::chrono::milliseconds a_debounce, std::function<void()> a_onChange) :
+	directories(std::move(a_directories)),
+	interval(a_interval),
+	debounce(a_debounce),
+	onChange(std::move(a_onChange)),
+	thread([this](std::stop_token a_stop) { Run(a_stop); })
+{
+}
+
+ConfigWatcher::~ConfigWatcher()
+{
+	thread.request_stop();
+	condition.notify_all();
+}
+
+auto ConfigWatcher::Scan() const -> Snapshot
+{
+	Snapshot snapshot;
+	for (const auto& directory : directories) {
+		// The dedicated directory usually does not exist, searching it would log an error on every poll
+		ConfigCache::FileStamp stamp;
+		if (!ConfigFile::Stat(directory.string(), stamp))
+			continue;
+		Loader::FindConfigs(directory, [&](const std::string& a_path, std::string_view) {
+			ConfigCache::FileStamp stamp;
+			ConfigCache::GetFileStamp(a_path, stamp);
+			snapshot.emplace(a_path, std::make_pair(stamp.size, stamp.time));
+		});
+	}
+	return snapshot;
+}
+
+void ConfigWatcher::Run(std::stop_token a_stop)
+{
+	auto last = Scan();
+	std::optional<std::chrono::steady_clock::time_point> changedAt;
+	while (true) {
+		{
+			std::unique_lock lock{ mutex };
+			if (condition.wait_for(lock, a_stop, interval, [&a_stop]() { return a_stop.stop_requested(); }))
+				return;
+		}
+
+		auto current = Scan();
+		const auto now = std::chrono::steady_clock::now();
+		if (current != last) {
+			last = std::move(current);
+			changedAt = now;
+		} else if (changedAt && now - *changedAt >= debounce) {
+			changedAt.reset();
+			onChange();
+		}
+	}
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <thread>
+
+// Checks the configs of a few directories on a background thread and calls back once they have changed and then
+// stayed unchanged for the debounce interval, so that a save in progress is not picked up halfway
+class ConfigWatcher
+{
+public:
+	ConfigWatcher(std::vector<std::filesystem::path> a_directories, std::chrono::milliseconds a_interval, std::chrono::milliseconds a_debounce, std::function<void()> a_onChange);
+	~ConfigWatcher();
+
+	ConfigWatcher(const ConfigWatcher&) = delete;
+	ConfigWatcher& operator=(const ConfigWatcher&) = delete;
+
+private:
+	// Size and time of every config, by path
+	using Snapshot = std::map<std::string, std::pair<std::uint64_t, std::int64_t>>;
+
+	Snapshot Scan() const;
+	void Run(std::stop_token a_stop);
+
+	std::vector<std::filesystem::path> directories;
+	std::chrono::milliseconds interval;
+	std::chrono::milliseconds debounce;
+	std::function<void()> onChange;
+
+	std::mutex mutex;
+	std::condition_variable_any condition;
+	// Declared last so that it is joined before anything it uses is destroyed
+	std::jthread thread;
+};
@@ -0,0 +1,138 @@
+#include "ConflictReport.h"
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+ConflictReport ConflictReport::Build(ConflictStore& a_conflicts, Backend& a_backend)
+{
+	ConflictReport report;
+	const auto records = a_conflicts.GetGroupedRecords(a_backend);
+
+	report.files.reserve(a_conflicts.GetFileCount());
+	for (std::uint32_t i = 0; i < a_conflicts.GetFileCount(); i++)
+		report.files.emplace_back(a_conflicts.GetFilename(i));
+	report.writers.reserve(records.size());
+
+	std::unordered_map<Form*, std::uint32_t> formIndices;
+	const auto intern = [&](Form* a_form) {
+		const auto [it, inserted] = formIndices.try_emplace(a_form, static_cast<std::uint32_t>(report.forms.size()));
+		if (inserted)
+			report.forms.emplace_back(a_backend.GetIdentifier(a_form));
+		return it->second;
+	};
+
+	for (std::size_t i = 0; i < records.size();) {
+		const auto& record = records[i];
+		Entry entry{ intern(record.form), record.subform ? intern(record.subform) : NO_SUBFORM, static_cast<std::uint32_t>(report.writers.size()), 0, record.field };
+		for (; i < records.size() && records[i].form == record.form && records[i].subform == record.subform && records[i].field == record.field; i++) {
+			report.writers.emplace_back(records[i].file);
+			entry.writerCount++;
+		}
+		report.entries.emplace_back(entry);
+	}
+	return report;
+}
+
+std::string ConflictReport::ToText() const
+{
+	std::string buffer;
+	// The same layout is walked twice, the first pass only measures so that the buffer is allocated once
+	for (const bool measure : { true, false }) {
+		std::size_t size = 0;
+		bool first = true;
+		const auto append = [&](std::string_view a_string) {
+			if (measure)
+				size += a_string.size();
+			else
+				buffer.append(a_string);
+		};
+		const auto line = [&]() {
+			if (!first)
+				append("\n"sv);
+			first = false;
+		};
+
+		auto lastForm = NO_SUBFORM;
+		auto lastSubform = NO_SUBFORM;
+		for (const auto& entry : entries) {
+			if (entry.form != lastForm) {
+				line();
+				line();
+				append(forms[entry.form]);
+				lastForm = entry.form;
+				lastSubform = NO_SUBFORM;
+			}
+			if (entry.subform != NO_SUBFORM && entry.subform != lastSubform) {
+				line();
+				append("\t"sv);
+				append(forms[entry.subform]);
+				lastSubform = entry.subform;
+			}
+			line();
+			append(entry.subform != NO_SUBFORM ? "\t\t"sv : "\t"sv);
+			append(GetFieldName(entry.field));
+			append(" "sv);
+			for (std::uint32_t i = 0; i < entry.writerCount; i++) {
+				append(" -> "sv);
+				append(files[writers[entry.firstWriter + i]]);
+			}
+		}
+
+		if (measure)
+			buffer.reserve(size);
+	}
+	return buffer;
+}
+
+std::string ConflictReport::ToJSON() const
+{
+	json data = json::array();
+	for (const auto& entry : entries) {
+		json record;
+		record["Form"] = forms[entry.form];
+		if (entry.subform != NO_SUBFORM)
+			record["Sound"] = forms[entry.subform];
+		record["Field"] = std::string{ GetFieldName(entry.field) };
+		auto& recordFiles = record["Files"] = json::array();
+		for (std::uint32_t i = 0; i < entry.writerCount; i++)
+			recordFiles.emplace_back(files[writers[entry.firstWriter + i]]);
+		data.emplace_back(std::move(record));
+	}
+	return data.dump(1, '\t');
+}
+
+std::string ConflictReport::ToCSV() const
+{
+	const auto append = [](std::string& a_buffer, std::string_view a_value) {
+		if (a_value.find_first_of(",\"\n"sv) == std::string_view::npos) {
+			a_buffer.append(a_value);
+			return;
+		}
+		a_buffer.push_back('"');
+		for (const auto c : a_value) {
+			if (c == '"')
+				a_buffer.push_back('"');
+			a_buffer.push_back(c);
+		}
+		a_buffer.push_back('"');
+	};
+
+	std::string buffer = "Form,Sound,Field,Order,File\n";
+	buffer.reserve(writers.size() * 96);
+	for (const auto& entry : entries) {
+		for (std::uint32_t i = 0; i < entry.writerCount; i++) {
+			append(buffer, forms[entry.form]);
+			buffer.push_back(',');
+			if (entry.subform != NO_SUBFORM)
+				append(buffer, forms[entry.subform]);
+			buffer.push_back(',');
+			append(buffer, GetFieldName(entry.field));
+			buffer.push_back(',');
+			buffer.append(std::to_string(i));
+			buffer.push_back(',');
+			append(buffer, files[writers[entry.firstWriter + i]]);
+			buffer.push_back('\n');
+		}
+	}
+	return buffer;
+}
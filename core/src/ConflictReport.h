@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ConflictStore.h"
+
+// Self-contained snapshot of a ConflictStore, taken on the main thread so that
+// formatting and writing can happen on a background thread afterwards
+class ConflictReport
+{
+public:
+	static ConflictReport Build(ConflictStore& a_conflicts, Backend& a_backend);
+
+	std::string ToText() const;
+	std::string ToJSON() const;
+	std::string ToCSV() const;
+
+	std::size_t GetEntryCount() const { return entries.size(); }
+
+private:
+	static constexpr auto NO_SUBFORM = std::numeric_limits<std::uint32_t>::max();
+
+	struct Entry
+	{
+		std::uint32_t form;
+		std::uint32_t subform;
+		std::uint32_t firstWriter;
+		std::uint32_t writerCount;
+		Field field;
+	};
+
+	std::vector<std::string> forms;
+	std::vector<std::string> files;
+	std::vector<Entry> entries;
+	std::vector<std::uint32_t> writers;
+};
@@ -0,0 +1,53 @@
+#include "ConflictStore.h"
+
+std::uint32_t ConflictStore::InternFile(std::string_view a_path)
+{
+	if (auto it = fileIndices.find(a_path); it != fileIndices.end())
+		return it->second;
+	const auto index = static_cast<std::uint32_t>(files.size());
+	fileIndices.emplace(files.emplace_back(a_path), index);
+	return index;
+}
+
+void ConflictStore::Insert(Form* a_form, Form* a_subform, std::uint32_t a_file, std::span<const Field> a_fields)
+{
+	for (const auto field : a_fields)
+		records.emplace_back(a_form, a_subform, a_file, field);
+	grouped = grouped && a_fields.empty();
+}
+
+std::span<const ConflictStore::Record> ConflictStore::GetGroupedRecords(Backend& a_backend)
+{
+	if (!grouped) {
+		// Region sounds first, then forms by FormID, stable so that files stay in apply order
+		std::ranges::stable_sort(records, [&](const Record& a_lhs, const Record& a_rhs) {
+			const auto key = [&](const Record& a_record) {
+				return std::make_tuple(a_record.subform == nullptr, a_backend.GetFormID(a_record.form), a_record.subform ? a_backend.GetFormID(a_record.subform) : 0, a_record.field);
+			};
+			return key(a_lhs) < key(a_rhs);
+		});
+		grouped = true;
+	}
+	return records;
+}
+
+std::size_t ConflictStore::GetMemoryUsage() const
+{
+	std::size_t usage = records.capacity() * sizeof(Record);
+	for (const auto& file : files)
+		usage += sizeof(std::string) + file.capacity();
+	return usage + fileIndices.size() * (sizeof(std::string_view) + sizeof(std::uint32_t) + 2 * sizeof(void*));
+}
+
+void ConflictStore::Clear()
+{
+	ClearRecords();
+	fileIndices.clear();
+	files.clear();
+}
+
+void ConflictStore::ClearRecords()
+{
+	records = {};
+	grouped = true;
+}
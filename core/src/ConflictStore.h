@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Backend.h"
+
+// Flat record of every field written by every config, grouped by form and field only when reported
+class ConflictStore
+{
+public:
+	struct Record
+	{
+		Form* form;
+		Form* subform;
+		std::uint32_t file;
+		Field field;
+	};
+
+	// Files are identified and reported by their path, configs of the same name in different directories stay apart
+	std::uint32_t InternFile(std::string_view a_path);
+	std::string_view GetFilename(std::uint32_t a_file) const { return files[a_file]; }
+	std::uint32_t GetFileCount() const { return static_cast<std::uint32_t>(files.size()); }
+
+	void Insert(Form* a_form, Form* a_subform, std::uint32_t a_file, std::span<const Field> a_fields);
+
+	// Sorts records so that every (form, subform, field) group is contiguous, with writers in the order they were applied
+	std::span<const Record> GetGroupedRecords(Backend& a_backend);
+
+	std::size_t GetMemoryUsage() const;
+	void Clear();
+	// Keeps the file indices, for a plan that still refers to them
+	void ClearRecords();
+
+private:
+	std::vector<Record> records;
+	// Indices view into paths owned by this deque, which never moves its elements
+	std::deque<std::string> files;
+	std::unordered_map<std::string_view, std::uint32_t> fileIndices;
+	bool grouped = true;
+};
@@ -0,0 +1,93 @@
+#include "ErrorReport.h"
+
+#include "Log.h"
+
+namespace
+{
+	constexpr std::array<std::string_view, std::to_underlying(ErrorReport::Kind::kTotal)> KIND_NAMES{
+		"unreadable configs"sv,
+		"invalid entries"sv,
+		"missing forms"sv,
+		"regions without sound data"sv
+	};
+
+	constexpr std::size_t MAX_SUMMARY_FILES = 5;
+}
+
+void ErrorReport::Add(Kind a_kind, std::string_view a_file, std::string_view a_message)
+{
+	std::lock_guard lock{ mutex };
+
+	auto [fileIt, newFile] = fileIndices.try_emplace(std::string{ a_file }, static_cast<std::uint32_t>(files.size()));
+	if (newFile)
+		files.emplace_back(a_file);
+
+	std::string key;
+	key.reserve(a_message.size() + 8);
+	key.push_back(static_cast<char>(a_kind));
+	key.append(reinterpret_cast<const char*>(&fileIt->second), sizeof(std::uint32_t));
+	key.append(a_message);
+
+	auto [errorIt, newError] = errorIndices.try_emplace(std::move(key), errors.size());
+	if (newError)
+		errors.emplace_back(a_kind, fileIt->second, std::string{ a_message }, 1);
+	else
+		errors[errorIt->second].count++;
+}
+
+std::string ErrorReport::BuildSummary() const
+{
+	std::array<std::uint32_t, std::to_underlying(Kind::kTotal)> kindCounts{};
+	std::vector<std::uint32_t> fileCounts(files.size());
+	std::uint32_t total = 0;
+	for (const auto& error : errors) {
+		kindCounts[std::to_underlying(error.kind)] += error.count;
+		fileCounts[error.file] += error.count;
+		total += error.count;
+	}
+
+	const auto fileCount = std::ranges::count_if(fileCounts, [](auto a_count) { return a_count > 0; });
+	std::string summary = std::format("{} found {} problems in {} configs\n", Core::NAME, total, fileCount);
+	for (std::size_t i = 0; i < kindCounts.size(); i++) {
+		if (kindCounts[i])
+			summary += std::format("\n{} {}", kindCounts[i], KIND_NAMES[i]);
+	}
+
+	std::vector<std::uint32_t> order(files.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::ranges::stable_sort(order, std::greater{}, [&](auto a_file) { return fileCounts[a_file]; });
+
+	summary += "\n";
+	for (std::size_t i = 0; i < std::min(order.size(), MAX_SUMMARY_FILES) && fileCounts[order[i]]; i++)
+		summary += std::format("\n{}: {}", files[order[i]], fileCounts[order[i]]);
+	if (static_cast<std::size_t>(fileCount) > MAX_SUMMARY_FILES)
+		summary += std::format("\n...and {} more", fileCount - MAX_SUMMARY_FILES);
+
+	summary += std::format("\n\nSee {}.log for details", Core::NAME);
+	return summary;
+}
+
+std::string ErrorReport::Flush()
+{
+	std::lock_guard lock{ mutex };
+	if (errors.empty())
+		return {};
+
+	auto& log = Log::Get(Log::Category::kReport);
+	log.error("\n{} unique errors:", errors.size());
+	for (const auto& error : errors) {
+		if (error.count > 1)
+			log.error("	[{}] {} (x{})", files[error.file], error.message, error.count);
+		else
+			log.error("	[{}] {}", files[error.file], error.message);
+	}
+
+	auto summary = BuildSummary();
+	log.error("\n{}", summary);
+
+	errors.clear();
+	errorIndices.clear();
+	files.clear();
+	fileIndices.clear();
+	return summary;
+}
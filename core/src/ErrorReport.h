@@ -0,0 +1,38 @@
+#pragma once
+
+// Collects errors from every stage of a load so that they can be reported once, deduplicated, instead of one message box each
+class ErrorReport
+{
+public:
+	enum class Kind : std::uint8_t
+	{
+		kBadFile,
+		kInvalidEntry,
+		kMissingForm,
+		kMissingRegionSound,
+
+		kTotal
+	};
+
+	void Add(Kind a_kind, std::string_view a_file, std::string_view a_message);
+
+	// Logs every error and returns a single summary to show the user, empty if there were none
+	std::string Flush();
+
+private:
+	struct Error
+	{
+		Kind kind;
+		std::uint32_t file;
+		std::string message;
+		std::uint32_t count;
+	};
+
+	std::string BuildSummary() const;
+
+	std::mutex mutex;
+	std::vector<Error> errors;
+	std::vector<std::string> files;
+	std::unordered_map<std::string, std::uint32_t> fileIndices;
+	std::unordered_map<std::string, std::size_t> errorIndices;
+};
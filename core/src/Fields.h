@@ -0,0 +1,78 @@
+#pragma once
+
+// Every record field a config can patch, used as a compact key for conflict tracking
+enum class Field : std::uint8_t
+{
+	kPickUp,
+	kPutDown,
+	kImpactDataSet,
+	kAttack,
+	kAttack2D,
+	kAttackLoop,
+	kAttackFail,
+	kIdle,
+	kEquip,
+	kUnequip,
+	kSheatheDraw,
+	kCharge,
+	kReady,
+	kRelease,
+	kCastLoop,
+	kOnHit,
+	kFootstep,
+	kActive,
+	kCountdown,
+	kDeactivate,
+	kInterior,
+	kExterior,
+	kAmbient,
+	kConsume,
+	kOpen,
+	kClose,
+	kLoop,
+	kActivate,
+	kSound,
+	kFlags,
+	kChance,
+
+	kTotal
+};
+
+inline constexpr std::array<std::string_view, std::to_underlying(Field::kTotal)> FIELD_NAMES{
+	"Pick Up"sv,
+	"Put Down"sv,
+	"Impact Data Set"sv,
+	"Attack"sv,
+	"Attack 2D"sv,
+	"Attack Loop"sv,
+	"Attack Fail"sv,
+	"Idle"sv,
+	"Equip"sv,
+	"Unequip"sv,
+	"Sheathe/Draw"sv,
+	"Charge"sv,
+	"Ready"sv,
+	"Release"sv,
+	"Cast Loop"sv,
+	"On Hit"sv,
+	"Footstep"sv,
+	"Active"sv,
+	"Countdown"sv,
+	"Deactivate"sv,
+	"Interior"sv,
+	"Exterior"sv,
+	"Ambient"sv,
+	"Consume"sv,
+	"Open"sv,
+	"Close"sv,
+	"Loop"sv,
+	"Activate"sv,
+	"Sound"sv,
+	"Flags"sv,
+	"Chance"sv
+};
+
+constexpr std::string_view GetFieldName(Field a_field)
+{
+	return FIELD_NAMES[std::to_underlying(a_field)];
+}
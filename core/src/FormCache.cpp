@@ -0,0 +1,36 @@
+#include "FormCache.h"
+
+std::optional<Form*> FormCache::Find(std::string_view a_identifier, FormType a_formType)
+{
+	auto it = forms.find(Key{ a_identifier, a_formType });
+	if (it == forms.end()) {
+		misses++;
+		return std::nullopt;
+	}
+	hits++;
+	return it->second;
+}
+
+std::optional<Form*> FormCache::Peek(std::string_view a_identifier, FormType a_formType) const
+{
+	const auto it = forms.find(Key{ a_identifier, a_formType });
+	if (it == forms.end())
+		return std::nullopt;
+	return it->second;
+}
+
+void FormCache::Store(std::string_view a_identifier, FormType a_formType, Form* a_form)
+{
+	if (forms.contains(Key{ a_identifier, a_formType }))
+		return;
+	const auto& identifier = identifiers.emplace_back(a_identifier);
+	forms.emplace(Key{ identifier, a_formType }, a_form);
+}
+
+void FormCache::Clear()
+{
+	forms.clear();
+	identifiers.clear();
+	hits = 0;
+	misses = 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Forms.h"
+#include "StringUtil.h"
+
+// Memoizes identifier resolution for the duration of a load, including identifiers that failed to resolve
+class FormCache
+{
+public:
+	// Returns nullopt if the identifier has not been resolved yet, a nullptr if it failed to resolve
+	std::optional<Form*> Find(std::string_view a_identifier, FormType a_formType);
+	void Store(std::string_view a_identifier, FormType a_formType, Form* a_form);
+	// Like Find, but does not count as a hit or miss
+	std::optional<Form*> Peek(std::string_view a_identifier, FormType a_formType) const;
+	void Clear();
+
+	std::size_t GetSize() const { return forms.size(); }
+	std::uint64_t GetHits() const { return hits; }
+	std::uint64_t GetMisses() const { return misses; }
+
+private:
+	struct Key
+	{
+		std::string_view identifier;
+		FormType formType;
+	};
+
+	struct KeyHash
+	{
+		std::size_t operator()(const Key& a_key) const
+		{
+			return StringUtil::CaseInsensitiveHash{}(a_key.identifier) ^ std::to_underlying(a_key.formType);
+		}
+	};
+
+	struct KeyEqual
+	{
+		bool operator()(const Key& a_lhs, const Key& a_rhs) const
+		{
+			return a_lhs.formType == a_rhs.formType && StringUtil::EqualsInsensitive(a_lhs.identifier, a_rhs.identifier);
+		}
+	};
+
+	// Keys view into identifiers owned by this deque, which never moves its elements
+	std::deque<std::string> identifiers;
+	std::unordered_map<Key, Form*, KeyHash, KeyEqual> forms;
+	std::uint64_t hits = 0;
+	std::uint64_t misses = 0;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+// Opaque handle to a form owned by a Backend, the core only compares and hashes these
+struct Form;
+
+using FormID = std::uint32_t;
+
+// Every form type a config can patch or reference, backends map these to their own
+enum class FormType : std::uint8_t
+{
+	kNone,
+	kRegion,
+	kWeapon,
+	kMagicEffect,
+	kArmorAddon,
+	kArmor,
+	kMiscItem,
+	kSoulGem,
+	kProjectile,
+	kExplosion,
+	kEffectShader,
+	kIngestible,
+	kAmmo,
+	kBook,
+	kKey,
+	kDoor,
+	kContainer,
+	kActivator,
+	kSoundDescriptor,
+	kImpactDataSet,
+	kFootstepSet,
+
+	kTotal
+};
+
+// Record signatures, as the game names them in its own messages
+inline constexpr std::array<std::string_view, std::to_underlying(FormType::kTotal)> FORM_TYPE_NAMES{
+	"NONE"sv,
+	"REGN"sv,
+	"WEAP"sv,
+	"MGEF"sv,
+	"ARMA"sv,
+	"ARMO"sv,
+	"MISC"sv,
+	"SLGM"sv,
+	"PROJ"sv,
+	"EXPL"sv,
+	"EFSH"sv,
+	"ALCH"sv,
+	"AMMO"sv,
+	"BOOK"sv,
+	"KEYM"sv,
+	"DOOR"sv,
+	"CONT"sv,
+	"ACTI"sv,
+	"SNDR"sv,
+	"IPDS"sv,
+	"FSTS"sv
+};
+
+constexpr std::string_view GetFormTypeName(FormType a_formType)
+{
+	return FORM_TYPE_NAMES[std::to_underlying(a_formType)];
+}
+
+// Whether forms of a_formType are also forms of a_base, as the game derives soul gems and keys from misc items
+constexpr bool IsDerivedFormType(FormType a_formType, FormType a_base)
+{
+	if (a_formType == a_base)
+		return true;
+	return a_base == FormType::kMiscItem && (a_formType == FormType::kSoulGem || a_formType == FormType::kKey);
+}
+
+constexpr std::optional<FormType> FindFormType(std::string_view a_name)
+{
+	for (std::size_t i = 0; i < FORM_TYPE_NAMES.size(); i++) {
+		if (FORM_TYPE_NAMES[i] == a_name)
+			return static_cast<FormType>(i);
+	}
+	return std::nullopt;
+}
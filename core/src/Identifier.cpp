@@ -0,0 +1,54 @@
+#include "Identifier.h"
+
+#include "StringUtil.h"
+
+namespace
+{
+	constexpr std::string_view Trim(std::string_view a_string)
+	{
+		while (!a_string.empty() && (a_string.front() == ' ' || a_string.front() == '\t'))
+			a_string.remove_prefix(1);
+		while (!a_string.empty() && (a_string.back() == ' ' || a_string.back() == '\t'))
+			a_string.remove_suffix(1);
+		return a_string;
+	}
+
+	bool ParseHex(std::string_view a_string, FormID& a_value)
+	{
+		if (a_string.size() > 2 && a_string[0] == '0' && (a_string[1] == 'x' || a_string[1] == 'X'))
+			a_string.remove_prefix(2);
+		if (a_string.empty())
+			return false;
+		const auto end = a_string.data() + a_string.size();
+		const auto [ptr, ec] = std::from_chars(a_string.data(), end, a_value, 16);
+		return ec == std::errc{} && ptr == end;
+	}
+}
+
+auto Identifier::Parse(std::string_view a_identifier) -> std::optional<FormIdentifier>
+{
+	const auto separator = a_identifier.find('|');
+	if (separator == std::string_view::npos)
+		return std::nullopt;
+
+	const auto left = Trim(a_identifier.substr(0, separator));
+	const auto right = Trim(a_identifier.substr(separator + 1));
+
+	FormIdentifier identifier;
+	if (!StringUtil::GetPluginPrefix(left).empty() && ParseHex(right, identifier.localID)) {
+		identifier.plugin = left;
+		return identifier;
+	}
+	if (!StringUtil::GetPluginPrefix(right).empty() && ParseHex(left, identifier.localID)) {
+		identifier.plugin = right;
+		return identifier;
+	}
+	return std::nullopt;
+}
+
+auto Identifier::Lookup(Backend& a_backend, std::string_view a_identifier) -> Form*
+{
+	if (const auto identifier = Parse(a_identifier))
+		return a_backend.LookupForm(identifier->plugin, identifier->localID);
+	return a_backend.LookupEditorID(a_identifier);
+}
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Backend.h"
+
+namespace Identifier
+{
+	struct FormIdentifier
+	{
+		std::string_view plugin;
+		FormID localID;
+	};
+
+	// Parses "Plugin.esp|0x800" or "800|Plugin.esp" without allocating
+	auto Parse(std::string_view a_identifier) -> std::optional<FormIdentifier>;
+
+	// Resolves either a FormID identifier or an EditorID
+	auto Lookup(Backend& a_backend, std::string_view a_identifier) -> Form*;
+}
@@ -0,0 +1,91 @@
+#include "LoadStats.h"
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+std::string LoadStats::ToJSON() const
+{
+	json data;
+
+	data["Timings"] = {
+		{ "Discovery", timings.discovery },
+		{ "Parse Wait", timings.parseWait },
+		{ "Resolve", timings.resolve },
+		{ "Plan", timings.plan },
+		{ "Commit", timings.commit },
+		{ "Report", timings.report },
+		{ "Write", timings.write }
+	};
+
+	const auto openTime = std::accumulate(files.begin(), files.end(), 0.0, [](double a_total, const File& a_file) { return a_total + a_file.open; });
+
+	data["Discovery"] = {
+		{ "Entries Scanned", entriesScanned },
+		{ "Directories Indexed", directoriesIndexed },
+		{ "Configs", files.size() },
+		{ "Open Time", openTime },
+		{ "Bytes Read", bytesRead },
+		{ "Cache Hits", configCacheHits },
+		{ "Cache Misses", configCacheMisses }
+	};
+
+	data["Lookups"] = {
+		{ "Total", lookups },
+		{ "Unique", uniqueIdentifiers },
+		{ "Memo Hits", memoHits },
+		{ "Cache Hits", formCacheHits },
+		{ "Cache Misses", formCacheMisses },
+		{ "Missing", missingForms }
+	};
+
+	data["Fields"] = {
+		{ "Planned", fieldsPlanned },
+		{ "Written", fieldsWritten },
+		{ "Unchanged", fieldsUnchanged },
+		{ "Region Sounds Added", regionSoundsAdded },
+		{ "Conflicts", conflicts }
+	};
+
+	std::vector<std::size_t> order(categories.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::ranges::stable_sort(order, std::greater{}, [this](std::size_t a_index) { return categories[a_index].time; });
+
+	auto& categoryData = data["Categories"] = json::array();
+	for (const auto index : order) {
+		const auto& category = categories[index];
+		if (!category.records)
+			continue;
+		categoryData.push_back({
+			{ "Category", std::string{ Records::CATEGORY_NAMES[index] } },
+			{ "Time", category.time },
+			{ "Records", category.records },
+			{ "Lookups", category.lookups },
+			{ "Missing", category.missing },
+			{ "Planned", category.planned },
+			{ "Written", category.written } });
+	}
+
+	order.resize(files.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::ranges::stable_sort(order, std::greater{}, [this](std::size_t a_index) {
+		const auto& file = files[a_index];
+		return file.open + file.read + file.parse + file.apply;
+	});
+
+	auto& fileData = data["Files"] = json::array();
+	for (const auto index : order) {
+		const auto& file = files[index];
+		fileData.push_back({
+			{ "File", file.name },
+			{ "Time", file.open + file.read + file.parse + file.apply },
+			{ "Open", file.open },
+			{ "Read", file.read },
+			{ "Parse", file.parse },
+			{ "Apply", file.apply },
+			{ "Bytes", file.bytes },
+			{ "Records", file.records },
+			{ "Cached", file.cached } });
+	}
+
+	return data.dump(1, '\t');
+}
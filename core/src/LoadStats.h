@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Records.h"
+
+// Counters and timers of one load, filled in as it runs and written out as a single JSON file.
+// Times are in milliseconds, files and categories are written slowest first.
+class LoadStats
+{
+public:
+	// Configs are parsed while they are discovered and planned, so parsing only shows up as the time planning had to wait for it
+	struct Timings
+	{
+		double discovery = 0.0;
+		double parseWait = 0.0;
+		double resolve = 0.0;
+		double plan = 0.0;
+		double commit = 0.0;
+		double report = 0.0;
+		double write = 0.0;
+	};
+
+	struct File
+	{
+		std::string name;
+		std::uint64_t bytes = 0;
+		std::size_t records = 0;
+		// Served from the config cache instead of being parsed
+		bool cached = false;
+		// Opening and querying the size and time of the file, kept apart from reading since every open is expensive under a virtual filesystem
+		double open = 0.0;
+		double read = 0.0;
+		double parse = 0.0;
+		double apply = 0.0;
+	};
+
+	struct Category
+	{
+		std::size_t records = 0;
+		std::size_t lookups = 0;
+		std::size_t missing = 0;
+		std::size_t planned = 0;
+		std::size_t written = 0;
+		double time = 0.0;
+	};
+
+	Timings timings;
+
+	std::size_t entriesScanned = 0;
+	// Directories whose configs came from the discovery index instead of being searched
+	std::size_t directoriesIndexed = 0;
+	std::uint64_t bytesRead = 0;
+	std::size_t configCacheHits = 0;
+	std::size_t configCacheMisses = 0;
+
+	// Every identifier lookup, answered by the memo of this load, the persistent cache or the backend.
+	// The unique identifiers of each pipeline window of configs are resolved before it is planned, so most lookups are memo hits.
+	std::size_t lookups = 0;
+	std::size_t uniqueIdentifiers = 0;
+	std::size_t memoHits = 0;
+	std::size_t formCacheHits = 0;
+	std::size_t formCacheMisses = 0;
+	std::size_t missingForms = 0;
+
+	std::size_t fieldsPlanned = 0;
+	std::size_t fieldsWritten = 0;
+	std::size_t fieldsUnchanged = 0;
+	std::size_t regionSoundsAdded = 0;
+	std::size_t conflicts = 0;
+
+	std::vector<File> files;
+	std::array<Category, std::to_underlying(Records::Category::kTotal)> categories{};
+
+	Category& GetCategory(Records::Category a_category) { return categories[std::to_underlying(a_category)]; }
+
+	std::string ToJSON() const;
+};
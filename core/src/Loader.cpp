@@ -0,0 +1,773 @@
+#include "Loader.h"
+
+#include "ConflictReport.h"
+#include "Identifier.h"
+#include "Log.h"
+#include "Settings.h"
+
+Loader::Loader(Backend& a_backend, Options a_options) :
+	backend(a_backend),
+	options(std::move(a_options))
+{
+}
+
+void Loader::InsertConflictInformationRegions(Form* a_region, Form* a_sound, std::span<const Field> a_fields)
+{
+	conflicts.Insert(a_region, a_sound, currentFile, a_fields);
+}
+
+void Loader::InsertConflictInformation(Form* a_form, std::span<const Field> a_fields)
+{
+	conflicts.Insert(a_form, nullptr, currentFile, a_fields);
+}
+
+namespace
+{
+	double MillisecondsSince(std::chrono::steady_clock::time_point a_begin)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - a_begin).count();
+	}
+
+	using PathChar = std::filesystem::path::value_type;
+	using PathView = std::basic_string_view<PathChar>;
+
+	constexpr PathChar SEPARATORS[] = { '/', std::filesystem::path::preferred_separator, 0 };
+
+	// Compares against an ASCII suffix without converting a_name, which is wide on Windows
+	bool EndsWith(PathView a_name, std::string_view a_suffix)
+	{
+		if (a_name.size() < a_suffix.size())
+			return false;
+		return std::ranges::equal(a_name.substr(a_name.size() - a_suffix.size()), a_suffix, [](PathChar a_lhs, char a_rhs) { return a_lhs == static_cast<PathChar>(a_rhs); });
+	}
+
+	bool IsConfigName(PathView a_name)
+	{
+		for (const auto extension : { ".json"sv, ".jsonc"sv, ".yaml"sv }) {
+			if (EndsWith(a_name, extension))
+				return EndsWith(a_name.substr(0, a_name.size() - extension.size()), "_SRD"sv);
+		}
+		return false;
+	}
+
+	void AddConfig(const std::string& a_path, std::string_view a_filename, const Loader::FoundConfig& a_found)
+	{
+		const auto rawname = a_filename.substr(0, a_filename.find_last_of('.'));
+		if (rawname.contains(".es")) {
+			// The longest plugin name it may belong to, GetApplyOrder picks the one that is loaded
+			if (const auto prefixes = StringUtil::GetPluginPrefixes(rawname); !prefixes.empty())
+				a_found(a_path, prefixes.back());
+		} else {
+			a_found(a_path, {});
+		}
+	}
+}
+
+auto Loader::GetApplyOrder(std::span<const std::string> a_loadOrder, const ConfigSet& a_configs, const StringUtil::CaseInsensitiveMap<ConfigSet>& a_pluginConfigs) -> std::vector<std::string>
+{
+	StringUtil::CaseInsensitiveMap<std::size_t> positions;
+	for (std::size_t i = 0; i < a_loadOrder.size(); i++)
+		positions.try_emplace(a_loadOrder[i], i);
+
+	// Configs are found under the longest plugin name they may belong to, and go with the longest one that is loaded
+	std::vector<ConfigSet> loadedConfigs(a_loadOrder.size());
+	for (const auto& [plugin, paths] : a_pluginConfigs) {
+		const auto prefixes = StringUtil::GetPluginPrefixes(plugin);
+		for (auto prefix = prefixes.rbegin(); prefix != prefixes.rend(); ++prefix) {
+			if (const auto it = positions.find(*prefix); it != positions.end()) {
+				loadedConfigs[it->second].insert(paths.begin(), paths.end());
+				break;
+			}
+		}
+	}
+
+	std::vector<std::string> order;
+	for (const auto& paths : loadedConfigs)
+		order.insert(order.end(), paths.begin(), paths.end());
+	order.insert(order.end(), a_configs.begin(), a_configs.end());
+	return order;
+}
+
+bool Loader::ConfigOrder::operator()(std::string_view a_lhs, std::string_view a_rhs) const
+{
+	const auto lhs = a_lhs.substr(a_lhs.find_last_of("/\\"sv) + 1);
+	const auto rhs = a_rhs.substr(a_rhs.find_last_of("/\\"sv) + 1);
+	return lhs != rhs ? lhs < rhs : a_lhs < a_rhs;
+}
+
+std::filesystem::path Loader::GetConfigDirectory(const std::filesystem::path& a_dataDirectory)
+{
+	return a_dataDirectory / "SKSE" / "Plugins" / Core::NAME;
+}
+
+std::size_t Loader::FindConfigs(const std::filesystem::path& a_directory, const FoundConfig& a_found)
+{
+	std::size_t scanned = 0;
+	std::error_code ec;
+	for (const auto& entry : std::filesystem::directory_iterator(a_directory, ec)) {
+		scanned++;
+		// Only the few matching entries are converted to strings or checked on disk
+		const PathView path = entry.path().native();
+		if (!IsConfigName(path.substr(path.find_last_of(SEPARATORS) + 1)) || !entry.exists())
+			continue;
+		AddConfig(entry.path().string(), entry.path().filename().string(), a_found);
+	}
+	if (ec)
+		Log::Get(Log::Category::kDiscovery).error("Failed to search {}\n{}", a_directory.string(), ec.message());
+	return scanned;
+}
+
+void Loader::SearchConfigs(const FoundConfig& a_found, bool a_useIndex)
+{
+	// The dedicated directory is optional and searched first, the data directory is always searched
+	for (const auto* directory : { &options.configDirectory, &options.dataDirectory }) {
+		if (directory->empty())
+			continue;
+
+		const auto key = directory->string();
+		ConfigCache::FileStamp stamp;
+		if (!ConfigFile::Stat(key, stamp)) {
+			if (directory == &options.dataDirectory)
+				FindConfigs(*directory, a_found);
+			continue;
+		}
+
+		std::vector<std::string> names;
+		if (a_useIndex && cache.FindDirectory(key, stamp.time, names)) {
+			stats.directoriesIndexed++;
+			for (const auto& name : names)
+				AddConfig((*directory / name).string(), name, a_found);
+			continue;
+		}
+
+		// Stamped before the search, so that a config added while it runs invalidates the entry
+		stats.entriesScanned += FindConfigs(*directory, [&](const std::string& a_path, std::string_view a_plugin) {
+			if (a_useIndex)
+				names.push_back(std::filesystem::path(a_path).filename().string());
+			a_found(a_path, a_plugin);
+		});
+		if (a_useIndex)
+			cache.StoreDirectory(key, stamp.time, std::move(names));
+	}
+}
+
+void Loader::DiscoverConfigs()
+{
+	SearchConfigs([this](const std::string& a_path, std::string_view a_plugin) {
+		if (a_plugin.empty())
+			configs.insert(a_path);
+		else
+			pluginconfigs[std::string{ a_plugin }].insert(a_path);
+	},
+		options.indexDirectories && !options.cacheFile.empty());
+
+	// Pushed in the order they apply as far as it is known before the load order is, plugin-specific ones first, then the rest.
+	// Load puts plugin-specific ones in place and drops those of plugins that are not loaded.
+	for (const auto& [plugin, paths] : pluginconfigs) {
+		for (const auto& path : paths)
+			pipeline->Push(path);
+	}
+	for (const auto& path : configs)
+		pipeline->Push(path);
+}
+
+void Loader::Prefetch()
+{
+	if (prefetch.valid())
+		return;
+
+	WaitForReport();
+	stats = {};
+	pipeline = std::make_unique<ConfigPipeline>(&cache);
+	prefetch = std::async(std::launch::async, [this]() {
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+		if (!options.cacheFile.empty())
+			cache.Load(options.cacheFile);
+		DiscoverConfigs();
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		stats.timings.discovery = std::chrono::duration<double, std::milli>(end - begin).count();
+		Log::Get(Log::Category::kDiscovery).info("\nSearched files in {} milliseconds\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count());
+	});
+}
+
+void Loader::Load()
+{
+	Prefetch();
+	prefetch.get();
+
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+	cache.SetPluginHash(backend.GetLoadOrderHash());
+
+	const auto loadOrder = backend.GetPlugins();
+	pluginTable = PluginTable{ loadOrder };
+	const auto order = GetApplyOrder(loadOrder, configs, pluginconfigs);
+	pipeline->SetOrder(order);
+
+	// Configs are resolved and applied a pipeline window at a time, so that configs Prefetch did not get to are parsed
+	// while the window before them is applied. Identifiers an earlier window resolved are found in formCache.
+	const std::span<const std::string> paths{ order };
+	const auto windowSize = pipeline->GetWindow();
+	std::vector<ParsedConfig> window;
+	window.reserve(windowSize);
+	for (std::size_t first = 0; first < paths.size(); first += windowSize) {
+		TakeConfigs(paths.subspan(first, std::min(windowSize, paths.size() - first)), window);
+
+		const auto resolveBegin = std::chrono::steady_clock::now();
+		ResolveIdentifiers(window);
+		stats.timings.resolve += MillisecondsSince(resolveBegin);
+
+		for (const auto& config : window)
+			ApplyConfig(config);
+		window.clear();
+	}
+	stats.timings.plan = MillisecondsSince(begin) - stats.timings.parseWait - stats.timings.resolve;
+
+	const auto commitBegin = std::chrono::steady_clock::now();
+	CommitPlan();
+	backend.CommitRegionSounds();
+	regionSoundData.clear();
+	stats.timings.commit = MillisecondsSince(commitBegin);
+
+	pipeline.reset();
+
+	Log::Get(Log::Category::kResolve).info("\nLooked up {} identifiers, {} resolved ahead, {} misses", formCache.GetHits() + formCache.GetMisses(), formCache.GetHits(), formCache.GetMisses());
+	formCache.Clear();
+
+	if (const auto summary = errors.Flush(); !summary.empty())
+		backend.ShowMessage(summary);
+
+	if (!options.cacheFile.empty())
+		cache.Save(options.cacheFile);
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	Log::Get(Log::Category::kApply).info("\nParsed configs in {} milliseconds", std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count());
+	begin = std::chrono::steady_clock::now();
+
+	Log::Get(Log::Category::kReport).info("Tracked {} field writes in {} KB", conflicts.GetGroupedRecords(backend).size(), conflicts.GetMemoryUsage() / 1024);
+	auto report = ConflictReport::Build(conflicts, backend);
+	if (Settings::GetSingleton()->hotReload.enabled)
+		conflicts.ClearRecords();
+	else
+		conflicts.Clear();
+	stats.conflicts = report.GetEntryCount();
+	stats.timings.report = MillisecondsSince(begin);
+
+	// Formatting and writing the report is left to a background thread so that loading can return
+	reportWriter = std::async(std::launch::async, [this, report = std::move(report), directory = options.reportDirectory]() {
+		std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+		if (report.GetEntryCount())
+			Log::Get(Log::Category::kReport).info("{}", report.ToText());
+
+		const auto settings = Settings::GetSingleton();
+		const auto format = settings->report.format;
+		if (!directory.empty() && format != Settings::ReportFormat::kNone) {
+			const bool csv = format == Settings::ReportFormat::kCSV;
+			const auto path = directory / std::format("{}_Conflicts.{}"sv, Core::NAME, csv ? "csv"sv : "json"sv);
+			const auto data = csv ? report.ToCSV() : report.ToJSON();
+			std::ofstream o(path, std::ios::binary | std::ios::trunc);
+			if (o.good())
+				o.write(data.data(), data.size());
+			else
+				Log::Get(Log::Category::kReport).error("Failed to write conflict report {}", path.string());
+		}
+
+		std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+		stats.timings.write = std::chrono::duration<double, std::milli>(end - begin).count();
+		Log::Get(Log::Category::kReport).info("\nWrote {} conflict entries in {} milliseconds\n", report.GetEntryCount(), std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count());
+
+		if (!directory.empty() && settings->report.stats) {
+			const auto path = directory / std::format("{}_Stats.json"sv, Core::NAME);
+			const auto data = stats.ToJSON();
+			std::ofstream o(path, std::ios::binary | std::ios::trunc);
+			if (o.good())
+				o.write(data.data(), data.size());
+			else
+				Log::Get(Log::Category::kReport).error("Failed to write load statistics {}", path.string());
+		}
+	});
+
+	end = std::chrono::steady_clock::now();
+	Log::Get(Log::Category::kReport).info("\nCollected conflicts in {} milliseconds\n", std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count());
+}
+
+void Loader::WaitForReport()
+{
+	if (reportWriter.valid())
+		reportWriter.get();
+}
+
+void Loader::TakeConfigs(std::span<const std::string> a_configs, std::vector<ParsedConfig>& a_parsed)
+{
+	for (const auto& config : a_configs) {
+		const auto begin = std::chrono::steady_clock::now();
+		a_parsed.push_back(pipeline->Take(config));
+		stats.timings.parseWait += MillisecondsSince(begin);
+	}
+}
+
+void Loader::ResolveIdentifiers(std::span<ParsedConfig> a_configs)
+{
+	struct Reference
+	{
+		std::string_view identifier;
+		FormType formType;
+		Records::Category category;
+		std::uint32_t config;
+		// Missing record forms only skip their entry, missing values are errors
+		bool value;
+	};
+
+	// Every reference of the configs that will be applied
+	std::vector<Reference> references;
+	for (std::uint32_t i = 0; i < a_configs.size(); i++) {
+		auto& config = a_configs[i];
+		if (!config.error.empty())
+			continue;
+		const auto requirements = pluginTable.Compile(config.data);
+		config.requirementsMet = requirements.Evaluate(pluginTable);
+		if (!config.requirementsMet) {
+			config.missingRequirements = requirements.Explain(pluginTable);
+			continue;
+		}
+		const auto add = [&](std::uint32_t a_string, FormType a_formType, Records::Category a_category, bool a_value) {
+			if (const auto identifier = config.data.GetString(a_string))
+				references.push_back({ *identifier, a_formType, a_category, i, a_value });
+		};
+		for (std::size_t j = 0; j < std::to_underlying(Records::Category::kTotal); j++) {
+			const auto category = static_cast<Records::Category>(j);
+			for (const auto& record : config.data.GetRecords(category)) {
+				add(record.form, Records::GetFormType(category), category, false);
+				for (const auto& value : config.data.GetValues(record)) {
+					if (category == Records::Category::kRegions) {
+						if (value.field == Field::kSound)
+							add(value.data, FormType::kSoundDescriptor, category, true);
+					} else if (const auto field = Records::FindField(category, value.field); field && field->valueType != FormType::kNone) {
+						add(value.data, field->valueType, category, true);
+					}
+				}
+			}
+		}
+	}
+
+	// Grouped by identifier and type regardless of case, each group is resolved once
+	const auto less = [](const Reference& a_lhs, const Reference& a_rhs) {
+		if (a_lhs.formType != a_rhs.formType)
+			return a_lhs.formType < a_rhs.formType;
+		return std::ranges::lexicographical_compare(a_lhs.identifier, a_rhs.identifier, {}, StringUtil::ToLower, StringUtil::ToLower);
+	};
+	std::ranges::stable_sort(references, less);
+	std::vector<std::size_t> groups;
+	for (std::size_t i = 0; i < references.size(); i++) {
+		if (i == 0 || less(references[i - 1], references[i]))
+			groups.push_back(i);
+	}
+	groups.push_back(references.size());
+
+	// Groups an earlier call already resolved are answered by formCache
+	std::vector<Form*> forms(groups.size() - 1);
+	std::vector<std::size_t> unresolved;
+	for (std::size_t i = 0; i + 1 < groups.size(); i++) {
+		const auto& reference = references[groups[i]];
+		if (const auto form = formCache.Peek(reference.identifier, reference.formType))
+			forms[i] = *form;
+		else
+			unresolved.push_back(i);
+	}
+	stats.uniqueIdentifiers += unresolved.size();
+
+	// Lookups only read, so the unique set is split into contiguous runs, each resolved by one worker
+	std::atomic<std::size_t> cacheHits = 0;
+	const auto resolve = [&](std::size_t a_begin, std::size_t a_end) {
+		std::size_t hits = 0;
+		for (auto i = a_begin; i < a_end; i++) {
+			const auto& reference = references[groups[unresolved[i]]];
+			bool cached = false;
+			forms[unresolved[i]] = ResolveIdentifier(reference.identifier, reference.formType, cached);
+			hits += cached;
+		}
+		cacheHits += hits;
+	};
+
+	constexpr std::size_t RUN_SIZE = 256;
+	if (unresolved.size() <= RUN_SIZE) {
+		resolve(0, unresolved.size());
+	} else {
+		// Load resolves on the pipeline's workers, a reload has no pipeline and starts a pool for its one call
+		std::optional<ThreadPool> reloadPool;
+		auto& pool = pipeline ? pipeline->GetPool() : reloadPool.emplace();
+		std::vector<std::future<void>> tasks;
+		for (std::size_t begin = 0; begin < unresolved.size(); begin += RUN_SIZE)
+			tasks.push_back(pool.Submit([&resolve, begin, end = std::min(begin + RUN_SIZE, unresolved.size())]() { resolve(begin, end); }));
+		for (auto& task : tasks)
+			task.get();
+	}
+	stats.formCacheHits += cacheHits;
+	stats.formCacheMisses += unresolved.size() - cacheHits;
+
+	// Applying finds every identifier here and never asks the backend itself
+	for (const auto i : unresolved) {
+		const auto& reference = references[groups[i]];
+		formCache.Store(reference.identifier, reference.formType, forms[i]);
+	}
+	Log::Get(Log::Category::kResolve).info("\nResolved {} unique identifiers, {} from the cache", unresolved.size(), cacheHits.load());
+
+	// Every reference to a missing form is reported against its own config, whichever config ends up writing the field
+	std::vector<const Reference*> missing;
+	for (std::size_t i = 0; i + 1 < groups.size(); i++) {
+		if (forms[i])
+			continue;
+		for (auto j = groups[i]; j < groups[i + 1]; j++)
+			missing.push_back(&references[j]);
+	}
+	std::ranges::stable_sort(missing, {}, &Reference::config);
+	for (const auto reference : missing) {
+		stats.missingForms++;
+		stats.GetCategory(reference->category).missing++;
+		if (!reference->value)
+			continue;
+		const auto& path = a_configs[reference->config].path;
+		const auto name = GetFormTypeName(reference->formType);
+		std::string errorMessage = std::format("	Form {} of {} does not exist in {}, this entry may be incomplete", reference->identifier, name, path);
+		Log::Get(Log::Category::kResolve).error("{}", errorMessage);
+		errors.Add(ErrorReport::Kind::kMissingForm, path, std::format("Form {} of {} does not exist", reference->identifier, name));
+	}
+}
+
+Form* Loader::ResolveIdentifier(std::string_view a_identifier, FormType a_formType, bool& a_cached)
+{
+	const auto formType = std::to_underlying(a_formType);
+	if (const auto formID = cache.FindForm(a_identifier, formType)) {
+		if (const auto form = backend.LookupFormID(*formID); form && backend.IsFormType(form, a_formType)) {
+			a_cached = true;
+			return form;
+		}
+	}
+	const auto form = Identifier::Lookup(backend, a_identifier);
+	if (!form || !backend.IsFormType(form, a_formType))
+		return nullptr;
+	cache.StoreForm(a_identifier, formType, backend.GetFormID(form));
+	return form;
+}
+
+void Loader::ApplyConfig(const ParsedConfig& a_config)
+{
+	// Configs are told apart by path, one in the config directory may share its name with one in the data directory
+	Log::Get(Log::Category::kParse).info("Parsing {}", a_config.path);
+	currentFilename = a_config.path;
+	currentFile = conflicts.InternFile(a_config.path);
+	if (Settings::GetSingleton()->hotReload.enabled)
+		loadedConfigs.insert_or_assign(a_config.path, LoadedConfig{ a_config.stamp, currentFile });
+
+	stats.bytesRead += a_config.bytes;
+	if (a_config.cached)
+		stats.configCacheHits++;
+	else
+		stats.configCacheMisses++;
+	auto& file = stats.files.emplace_back();
+	file.name = a_config.path;
+	file.bytes = a_config.bytes;
+	file.records = a_config.data.GetRecordCount();
+	file.cached = a_config.cached;
+	file.open = a_config.openTime;
+	file.read = a_config.readTime;
+	file.parse = a_config.parseTime;
+
+	if (!a_config.error.empty()) {
+		Log::Get(Log::Category::kParse).error("{}", a_config.error);
+		errors.Add(ErrorReport::Kind::kBadFile, a_config.path, a_config.error);
+		return;
+	}
+	Log::Get(Log::Category::kParse).debug("	{} records in {} bytes", a_config.data.GetRecordCount(), a_config.data.GetMemoryUsage());
+	if (!a_config.requirementsMet) {
+		for (const auto& missing : a_config.missingRequirements)
+			Log::Get(Log::Category::kApply).info("	Missing requirement {}", missing);
+		return;
+	}
+
+	const auto begin = std::chrono::steady_clock::now();
+	try {
+		RunConfig(a_config.data);
+		file.apply = MillisecondsSince(begin);
+	} catch (const std::exception& exc) {
+		std::string errorMessage = std::format("Failed to parse {}\n{}", a_config.path, exc.what());
+		Log::Get(Log::Category::kApply).error("{}", errorMessage);
+		errors.Add(ErrorReport::Kind::kBadFile, a_config.path, exc.what());
+	}
+}
+
+std::size_t Loader::Reload()
+{
+	if (!Settings::GetSingleton()->hotReload.enabled) {
+		Log::Get(Log::Category::kApply).warn("Hot reload is disabled");
+		return 0;
+	}
+
+	// The report writer of the last Load reads its statistics, which a reload counts apart from
+	WaitForReport();
+	auto loadStats = std::exchange(stats, LoadStats{});
+	const auto count = ReloadChanged();
+	reloadStats = std::exchange(stats, std::move(loadStats));
+	return count;
+}
+
+std::size_t Loader::ReloadChanged()
+{
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+	// Searched in full, the files being edited may not have touched the directory stamps an index relies on
+	ConfigSet foundConfigs;
+	StringUtil::CaseInsensitiveMap<ConfigSet> foundPluginConfigs;
+	SearchConfigs([&](const std::string& a_path, std::string_view a_plugin) {
+		if (a_plugin.empty())
+			foundConfigs.insert(a_path);
+		else
+			foundPluginConfigs[std::string{ a_plugin }].insert(a_path);
+	},
+		false);
+
+	const auto order = GetApplyOrder(backend.GetPlugins(), foundConfigs, foundPluginConfigs);
+
+	// Unchanged configs are recognized by their stamp, or by their hash if they were only touched
+	std::vector<ParsedConfig> changed;
+	std::vector<std::uint32_t> replaced;
+	std::unordered_set<std::string_view> present;
+	std::string buffer;
+	for (const auto& path : order) {
+		present.insert(path);
+		ParsedConfig config;
+		config.path = path;
+		config.filename = std::filesystem::path(path).filename().string();
+
+		const auto it = loadedConfigs.find(path);
+		ConfigFile file{ path };
+		config.stamp = file.GetStamp();
+		if (it != loadedConfigs.end() && file.IsOpen() && it->second.stamp.size == config.stamp.size && it->second.stamp.time == config.stamp.time)
+			continue;
+
+		if (ConfigPipeline::ReadConfig(file, config.filename, buffer, config.error)) {
+			config.bytes = buffer.size();
+			config.stamp.hash = ConfigCache::Hash(buffer);
+			if (it != loadedConfigs.end() && it->second.stamp.hash == config.stamp.hash) {
+				it->second.stamp = config.stamp;
+				continue;
+			}
+			ConfigPipeline::ParseConfig(config, buffer);
+		}
+		if (it != loadedConfigs.end())
+			replaced.push_back(it->second.file);
+		changed.push_back(std::move(config));
+	}
+
+	std::size_t removed = 0;
+	for (auto it = loadedConfigs.begin(); it != loadedConfigs.end();) {
+		if (present.contains(it->first)) {
+			++it;
+			continue;
+		}
+		Log::Get(Log::Category::kDiscovery).info("Removed {}", it->first);
+		replaced.push_back(it->second.file);
+		it = loadedConfigs.erase(it);
+		removed++;
+	}
+
+	if (changed.empty() && !removed) {
+		Log::Get(Log::Category::kApply).info("No configs changed");
+		return 0;
+	}
+
+	// Every config is ranked again so that added ones fall into their place in the load order
+	for (std::uint32_t rank = 0; rank < order.size(); rank++)
+		plan.SetFileRank(conflicts.InternFile(order[rank]), rank);
+	plan.RemoveFiles(replaced);
+	ResolveIdentifiers(changed);
+	for (const auto& config : changed)
+		ApplyConfig(config);
+
+	CommitPlan();
+	backend.CommitRegionSounds();
+	regionSoundData.clear();
+	formCache.Clear();
+	conflicts.ClearRecords();
+
+	configs = std::move(foundConfigs);
+	pluginconfigs = std::move(foundPluginConfigs);
+
+	if (const auto summary = errors.Flush(); !summary.empty())
+		backend.ShowMessage(summary);
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	Log::Get(Log::Category::kApply).info("\nReloaded {} changed and {} removed configs in {} milliseconds", changed.size(), removed, std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count());
+	return changed.size() + removed;
+}
+
+bool Loader::LookupFormString(Form*& a_form, std::optional<std::string_view> a_identifier, FormType a_formType)
+{
+	if (!a_identifier) {
+		a_form = nullptr;
+		return true;
+	}
+
+	const auto formString = *a_identifier;
+	auto& category = stats.GetCategory(currentCategory);
+	stats.lookups++;
+	category.lookups++;
+
+	Form* ret = nullptr;
+	if (const auto cached = formCache.Find(formString, a_formType)) {
+		ret = *cached;
+		stats.memoHits++;
+	} else {
+		// Only reached for identifiers ResolveIdentifiers did not collect, such as those of unchanged configs a reload recommits.
+		// Those were reported when their config was applied.
+		bool cacheHit = false;
+		ret = ResolveIdentifier(formString, a_formType, cacheHit);
+		if (cacheHit)
+			stats.formCacheHits++;
+		else
+			stats.formCacheMisses++;
+		formCache.Store(formString, a_formType, ret);
+	}
+	if (!ret)
+		return false;
+	a_form = ret;
+	return true;
+}
+
+Form* Loader::LookupForm(const ConfigData& a_config, const ConfigData::Record& a_record, FormType a_formType)
+{
+	const auto identifier = a_config.GetString(a_record.form);
+	if (!identifier) {
+		std::string errorMessage = std::format("	Failed to parse entry in {}\nentry has no Form", currentFilename);
+		Log::Get(Log::Category::kApply).error("{}", errorMessage);
+		errors.Add(ErrorReport::Kind::kInvalidEntry, currentFilename, "entry has no Form");
+		return nullptr;
+	}
+
+	Form* ret = nullptr;
+	LookupFormString(ret, identifier, a_formType);
+	if (!ret) {
+		std::string errorMessage = std::format("	Form {} of {} does not exist in {}, skipping entry", *identifier, GetFormTypeName(a_formType), currentFilename);
+		Log::Get(Log::Category::kResolve).warn("{}", errorMessage);
+	}
+	return ret;
+}
+
+void Loader::PlanRecords(Records::Category a_category, const ConfigData& a_config, std::span<const ConfigData::Record> a_records)
+{
+	std::vector<Field> changes;
+	for (const auto& record : a_records) {
+		auto form = LookupForm(a_config, record, Records::GetFormType(a_category));
+		if (!form)
+			continue;
+
+		changes.clear();
+		for (const auto& value : a_config.GetValues(record)) {
+			const auto field = Records::FindField(a_category, value.field);
+			if (!field)
+				continue;
+			plan.AddField(form, a_category, *field, currentFile, a_config.GetString(value.data));
+			changes.emplace_back(field->field);
+			stats.fieldsPlanned++;
+			stats.GetCategory(a_category).planned++;
+		}
+		InsertConflictInformation(form, changes);
+	}
+}
+
+void Loader::PlanRegions(const ConfigData& a_config, std::span<const ConfigData::Record> a_records)
+{
+	for (const auto& record : a_records) {
+		auto regn = LookupForm(a_config, record, FormType::kRegion);
+		if (!regn)
+			continue;
+
+		auto [it, firstLookup] = regionSoundData.try_emplace(regn, false);
+		if (firstLookup)
+			it->second = backend.HasRegionSounds(regn);
+		if (!it->second) {
+			// Every config patching the region would hit the same problem, so it is only reported for the first
+			if (firstLookup) {
+				std::string errorMessage = std::format("RDSA entry does not exist in {}", backend.GetIdentifier(regn));
+				Log::Get(Log::Category::kApply).error("	{}", errorMessage);
+				errors.Add(ErrorReport::Kind::kMissingRegionSound, currentFilename, errorMessage);
+			}
+			continue;
+		}
+
+		// Each entry is a kSound value followed by its optional kFlags and kChance values
+		const auto values = a_config.GetValues(record);
+		for (std::size_t i = 0; i < values.size(); i++) {
+			if (values[i].field != Field::kSound)
+				continue;
+			std::optional<std::uint32_t> flags;
+			std::optional<float> chance;
+			for (auto j = i + 1; j < values.size() && values[j].field != Field::kSound; j++) {
+				if (values[j].field == Field::kFlags)
+					flags = values[j].data;
+				else if (values[j].field == Field::kChance)
+					chance = std::bit_cast<float>(values[j].data);
+			}
+
+			// The sound is part of the key, so unlike other fields it is resolved while planning
+			Form* sound = nullptr;
+			if (!LookupFormString(sound, a_config.GetString(values[i].data), FormType::kSoundDescriptor))
+				continue;
+
+			std::vector<Field> changes;
+			// The config that creates a sound also sets its default flags and chance
+			const bool created = plan.AddRegionSound(regn, sound, currentFile, flags, chance) && !backend.GetRegionSound(regn, sound);
+			stats.fieldsPlanned++;
+			stats.GetCategory(Records::Category::kRegions).planned++;
+			if (flags || created)
+				changes.emplace_back(Field::kFlags);
+			if (chance || created)
+				changes.emplace_back(Field::kChance);
+			InsertConflictInformationRegions(regn, sound, changes);
+		}
+	}
+}
+
+void Loader::CommitPlan()
+{
+	const auto commit = plan.Commit([this](const PatchPlan::Write& a_write, Records::Category a_category, FormType a_formType, Form*& a_value) {
+		currentCategory = a_category;
+		return LookupFormString(a_value, plan.GetIdentifier(a_write.identifier), a_formType);
+	}, backend);
+	// Reloading needs every write and the values they replaced
+	if (!Settings::GetSingleton()->hotReload.enabled)
+		plan.Clear();
+
+	stats.fieldsWritten = commit.applied;
+	stats.fieldsUnchanged = commit.unchanged;
+	stats.regionSoundsAdded = commit.added;
+	for (std::size_t i = 0; i < commit.categoryApplied.size(); i++)
+		stats.categories[i].written = commit.categoryApplied[i];
+
+	Log::Get(Log::Category::kApply).info("\nPlanned {} writes to {} fields, applied {}, {} already set, {} unresolved, {} reverted", commit.writes, commit.fields, commit.applied, commit.unchanged, commit.failed, commit.reverted);
+	Log::Get(Log::Category::kApply).info("\nAdded {} region sounds", commit.added);
+}
+
+void Loader::RunConfig(const ConfigData& a_config)
+{
+	for (std::size_t i = 0; i < std::to_underlying(Records::Category::kTotal); i++) {
+		const auto category = static_cast<Records::Category>(i);
+		const auto records = a_config.GetRecords(category);
+		if (records.empty())
+			continue;
+
+		const auto begin = std::chrono::steady_clock::now();
+		currentCategory = category;
+		if (category == Records::Category::kRegions)
+			PlanRegions(a_config, records);
+		else
+			PlanRecords(category, a_config, records);
+
+		auto& categoryStats = stats.GetCategory(category);
+		categoryStats.records += records.size();
+		categoryStats.time += MillisecondsSince(begin);
+	}
+}
@@ -0,0 +1,137 @@
+#pragma once
+
+#include "Backend.h"
+#include "ConfigCache.h"
+#include "ConfigData.h"
+#include "ConfigPipeline.h"
+#include "ConflictStore.h"
+#include "ErrorReport.h"
+#include "FormCache.h"
+#include "LoadStats.h"
+#include "PatchPlan.h"
+#include "PluginTable.h"
+#include "StringUtil.h"
+
+// Finds, parses and applies every config through a Backend, then reports errors and conflicts.
+// Prefetch may run as soon as the data directory is known, Load once the backend has its forms.
+class Loader
+{
+public:
+	struct Options
+	{
+		// Searched for *_SRD configs
+		std::filesystem::path dataDirectory = "Data";
+		// Searched for *_SRD configs before the data directory if it exists, empty to disable.
+		// GetConfigDirectory gives the usual one, next to the settings file.
+		std::filesystem::path configDirectory;
+		// Reuses the configs found in a directory while its modification time is unchanged, which needs a cache file.
+		// Must be off where directory times do not follow the files in them, as under a virtual filesystem.
+		bool indexDirectories = true;
+		// Parsed configs and resolved forms are kept here between loads, empty to disable
+		std::filesystem::path cacheFile;
+		// The conflict report is written here when enabled in Settings, empty to disable
+		std::filesystem::path reportDirectory;
+	};
+
+	using FoundConfig = std::function<void(const std::string& a_path, std::string_view a_plugin)>;
+
+	// Orders config paths by filename, so that configs apply in the same order whichever directory they were found in
+	struct ConfigOrder
+	{
+		bool operator()(std::string_view a_lhs, std::string_view a_rhs) const;
+	};
+	using ConfigSet = std::set<std::string, ConfigOrder>;
+
+	// Plugin-specific configs in load order, then the rest. a_pluginConfigs is keyed as FindConfigs reports configs,
+	// each goes with the longest loaded plugin whose name its own starts with, and is left out if there is none.
+	static std::vector<std::string> GetApplyOrder(std::span<const std::string> a_loadOrder, const ConfigSet& a_configs, const StringUtil::CaseInsensitiveMap<ConfigSet>& a_pluginConfigs);
+
+	// SKSE/Plugins/SoundRecordDistributor inside a_dataDirectory
+	static std::filesystem::path GetConfigDirectory(const std::filesystem::path& a_dataDirectory);
+
+	// Calls a_found with every *_SRD config directly inside a_directory, and if it is plugin-specific, the longest plugin name
+	// it may belong to. Its name may start with several, which one is only known against the load order. Returns the number of entries scanned.
+	static std::size_t FindConfigs(const std::filesystem::path& a_directory, const FoundConfig& a_found);
+
+	Loader(Backend& a_backend, Options a_options);
+
+	std::string currentFilename = "";
+	std::uint32_t currentFile = 0;
+	ConflictStore conflicts;
+	ErrorReport errors;
+
+	void InsertConflictInformationRegions(Form* a_region, Form* a_sound, std::span<const Field> a_fields);
+	void InsertConflictInformation(Form* a_form, std::span<const Field> a_fields);
+
+	void Prefetch();
+	void Load();
+	// Plans every record of a config whose requirements have been met
+	void RunConfig(const ConfigData& a_config);
+
+	// Reapplies configs that were changed, added or removed since they were last applied, reverting what they wrote before.
+	// Only available with hot reload enabled, must run where Load did. Returns the number of configs reloaded.
+	std::size_t Reload();
+
+	// Blocks until the conflict report of the last Load has been written
+	void WaitForReport();
+
+	// Complete once WaitForReport has returned
+	const LoadStats& GetStats() const { return stats; }
+	// Of the last Reload only, GetStats keeps describing the last Load
+	const LoadStats& GetReloadStats() const { return reloadStats; }
+
+private:
+	struct LoadedConfig
+	{
+		ConfigCache::FileStamp stamp;
+		std::uint32_t file;
+	};
+
+	// Searches the config and data directories, through the discovery index of the cache if a_useIndex is set
+	void SearchConfigs(const FoundConfig& a_found, bool a_useIndex);
+	void DiscoverConfigs();
+	// Waits for each of a_configs in turn and appends it to a_parsed
+	void TakeConfigs(std::span<const std::string> a_configs, std::vector<ParsedConfig>& a_parsed);
+	// Checks the requirements of each config, which are not evaluated again when it is applied. Then resolves every identifier
+	// the configs that pass use, once each per load and on all cores, so that planning and committing only ever find them
+	// in formCache. Reports every reference to a missing form.
+	void ResolveIdentifiers(std::span<ParsedConfig> a_configs);
+	// Only reads from the backend, and stores what it finds in the cache, which locks itself, so it may run on several threads at once
+	Form* ResolveIdentifier(std::string_view a_identifier, FormType a_formType, bool& a_cached);
+	void ApplyConfig(const ParsedConfig& a_config);
+	// Reload once the statistics it counts are its own
+	std::size_t ReloadChanged();
+
+	Backend& backend;
+	Options options;
+
+	ConfigSet configs;
+	StringUtil::CaseInsensitiveMap<ConfigSet> pluginconfigs;
+	ConfigCache cache;
+	FormCache formCache;
+	PatchPlan plan;
+	// Load order of the last Load, and every plugin a requirement has named since
+	PluginTable pluginTable;
+	// Applied configs by path, kept while hot reload is enabled
+	std::unordered_map<std::string, LoadedConfig> loadedConfigs;
+	// Whether each looked up region has sound data, so that a missing one is reported once
+	std::unordered_map<Form*, bool> regionSoundData;
+	std::unique_ptr<ConfigPipeline> pipeline;
+	std::future<void> prefetch;
+	std::future<void> reportWriter;
+	// Filled in by whichever of Load and Reload is running
+	LoadStats stats;
+	LoadStats reloadStats;
+	// Category whose records are being planned or committed, lookups are counted against it
+	Records::Category currentCategory = Records::Category::kTotal;
+
+	void PlanRecords(Records::Category a_category, const ConfigData& a_config, std::span<const ConfigData::Record> a_records);
+	void PlanRegions(const ConfigData& a_config, std::span<const ConfigData::Record> a_records);
+	// Writes the final value of every field planned by ApplyConfig
+	void CommitPlan();
+
+	// A nullopt identifier is an explicit null in the config, which clears the field.
+	// Missing forms are reported by ResolveIdentifiers for every config that names them, not here.
+	bool LookupFormString(Form*& a_form, std::optional<std::string_view> a_identifier, FormType a_formType);
+	Form* LookupForm(const ConfigData& a_config, const ConfigData::Record& a_record, FormType a_formType);
+};
@@ -0,0 +1,129 @@
+#include "Log.h"
+
+#include "Settings.h"
+
+#include <spdlog/async.h>
+#include <spdlog/sinks/base_sink.h>
+
+namespace
+{
+	constexpr auto GLOBAL_LOGGER = "global log"sv;
+
+	// Forwards messages at or above the level configured for the logger they came from,
+	// and keeps the most recent ones below it in memory so that they can be written out as context when an error occurs
+	class FilterSink : public spdlog::sinks::base_sink<std::mutex>
+	{
+	public:
+		FilterSink(std::shared_ptr<spdlog::sinks::sink> a_target, std::size_t a_capacity) :
+			target(std::move(a_target)),
+			ring(a_capacity)
+		{
+		}
+
+		void SetLevel(std::string_view a_logger, spdlog::level::level_enum a_level)
+		{
+			levels.emplace_back(a_logger, a_level);
+		}
+
+	protected:
+		void sink_it_(const spdlog::details::log_msg& a_msg) override
+		{
+			if (a_msg.level < GetLevel({ a_msg.logger_name.data(), a_msg.logger_name.size() })) {
+				if (!ring.empty())
+					ring[next++ % ring.size()].assign(a_msg.payload.data(), a_msg.payload.size());
+				return;
+			}
+			if (a_msg.level >= spdlog::level::err)
+				Dump(a_msg);
+			target->log(a_msg);
+		}
+
+		void flush_() override
+		{
+			target->flush();
+		}
+
+		void set_pattern_(const std::string& a_pattern) override
+		{
+			target->set_pattern(a_pattern);
+		}
+
+		void set_formatter_(std::unique_ptr<spdlog::formatter> a_formatter) override
+		{
+			target->set_formatter(std::move(a_formatter));
+		}
+
+	private:
+		spdlog::level::level_enum GetLevel(std::string_view a_logger) const
+		{
+			for (const auto& [logger, level] : levels) {
+				if (logger == a_logger)
+					return level;
+			}
+			return spdlog::level::trace;
+		}
+
+		void Dump(const spdlog::details::log_msg& a_msg)
+		{
+			const auto count = std::min(next, ring.size());
+			if (!count)
+				return;
+			Write(a_msg, std::format("Last {} verbose messages before error:", count));
+			for (auto i = next - count; i < next; i++)
+				Write(a_msg, ring[i % ring.size()]);
+			next = 0;
+		}
+
+		void Write(const spdlog::details::log_msg& a_source, std::string_view a_payload)
+		{
+			spdlog::details::log_msg msg{ a_source.logger_name, spdlog::level::trace, spdlog::string_view_t{ a_payload.data(), a_payload.size() } };
+			target->log(msg);
+		}
+
+		std::shared_ptr<spdlog::sinks::sink> target;
+		std::vector<std::pair<std::string_view, spdlog::level::level_enum>> levels;
+		std::vector<std::string> ring;
+		std::size_t next = 0;
+	};
+
+	std::array<std::shared_ptr<spdlog::logger>, std::to_underlying(Log::Category::kTotal)> loggers;
+}
+
+void Log::Init(std::shared_ptr<spdlog::sinks::sink> a_target)
+{
+	const auto& settings = Settings::GetSingleton()->logging;
+
+	auto sink = std::make_shared<FilterSink>(std::move(a_target), settings.ringBufferSize);
+	const auto captureLevel = settings.ringBufferSize ? settings.ringBufferLevel : spdlog::level::off;
+
+	if (settings.async)
+		spdlog::init_thread_pool(8192, 1);
+
+	const auto makeLogger = [&](std::string_view a_name, spdlog::level::level_enum a_level) {
+		std::shared_ptr<spdlog::logger> log;
+		if (settings.async)
+			log = std::make_shared<spdlog::async_logger>(std::string{ a_name }, sink, spdlog::thread_pool(), spdlog::async_overflow_policy::block);
+		else
+			log = std::make_shared<spdlog::logger>(std::string{ a_name }, sink);
+		sink->SetLevel(a_name, a_level);
+		log->set_level(std::min(a_level, captureLevel));
+		log->flush_on(spdlog::level::err);
+		return log;
+	};
+
+	spdlog::set_default_logger(makeLogger(GLOBAL_LOGGER, settings.level));
+	for (std::size_t i = 0; i < loggers.size(); i++) {
+		loggers[i] = makeLogger(CATEGORY_NAMES[i], settings.categories[i]);
+		spdlog::register_logger(loggers[i]);
+	}
+
+	spdlog::set_pattern("%v");
+	if (settings.flushInterval)
+		spdlog::flush_every(std::chrono::seconds(settings.flushInterval));
+}
+
+spdlog::logger& Log::Get(Category a_category)
+{
+	const auto& log = loggers[std::to_underlying(a_category)];
+	return log ? *log : *spdlog::default_logger_raw();
+}
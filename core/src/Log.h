@@ -0,0 +1,27 @@
+#pragma once
+
+namespace Log
+{
+	enum class Category : std::uint8_t
+	{
+		kDiscovery,
+		kParse,
+		kResolve,
+		kApply,
+		kReport,
+
+		kTotal
+	};
+
+	inline constexpr std::array<std::string_view, std::to_underlying(Category::kTotal)> CATEGORY_NAMES{
+		"Discovery"sv,
+		"Parse"sv,
+		"Resolve"sv,
+		"Apply"sv,
+		"Report"sv
+	};
+
+	// Every message ends up in a_target, filtered by the levels in Settings
+	void Init(std::shared_ptr<spdlog::sinks::sink> a_target);
+	spdlog::logger& Get(Category a_category);
+}
@@ -0,0 +1,152 @@
+#include "MockBackend.h"
+
+#include "ConfigCache.h"
+
+void MockBackend::AddPlugin(std::string_view a_plugin)
+{
+	if (pluginIndices.contains(a_plugin))
+		return;
+	pluginIndices.emplace(a_plugin, static_cast<std::uint32_t>(plugins.size()));
+	plugins.emplace_back(a_plugin);
+	pluginVersions.push_back(0);
+}
+
+void MockBackend::UpdatePlugin(std::string_view a_plugin)
+{
+	if (const auto it = pluginIndices.find(a_plugin); it != pluginIndices.end())
+		pluginVersions[it->second]++;
+}
+
+Form* MockBackend::AddForm(FormType a_formType, std::string_view a_plugin, FormID a_localID, std::string_view a_editorID)
+{
+	AddPlugin(a_plugin);
+	const auto index = pluginIndices.find(a_plugin)->second;
+	auto [it, inserted] = formsByKey.try_emplace(GetKey(index, a_localID), nullptr);
+	if (!inserted)
+		return reinterpret_cast<Form*>(it->second);
+
+	const FormID localID = a_localID & 0xFFFFFF;
+	const FormID formID = index < 0xFE ? index << 24 | localID : nextHighFormID++;
+	auto& form = forms.emplace_back(formID, localID, a_formType, plugins[index], std::string{ a_editorID });
+	form.hasRegionSounds = a_formType == FormType::kRegion;
+	it->second = &form;
+	formsByID.emplace(formID, &form);
+	if (!a_editorID.empty())
+		formsByEditorID.try_emplace(std::string{ a_editorID }, &form);
+	return reinterpret_cast<Form*>(&form);
+}
+
+void MockBackend::SetHasRegionSounds(Form* a_region, bool a_hasSounds)
+{
+	Get(a_region).hasRegionSounds = a_hasSounds;
+}
+
+std::vector<std::string> MockBackend::GetPlugins()
+{
+	return plugins;
+}
+
+bool MockBackend::IsPluginLoaded(std::string_view a_plugin)
+{
+	return pluginIndices.contains(a_plugin);
+}
+
+std::uint64_t MockBackend::GetLoadOrderHash()
+{
+	std::uint64_t hash = ConfigCache::Hash({});
+	for (std::size_t i = 0; i < plugins.size(); i++) {
+		hash = ConfigCache::Hash(plugins[i], hash);
+		hash = ConfigCache::Hash({ reinterpret_cast<const char*>(&pluginVersions[i]), sizeof(std::uint32_t) }, hash);
+	}
+	return hash;
+}
+
+Form* MockBackend::LookupForm(std::string_view a_plugin, FormID a_localID)
+{
+	const auto plugin = pluginIndices.find(a_plugin);
+	if (plugin == pluginIndices.end())
+		return nullptr;
+	const auto it = formsByKey.find(GetKey(plugin->second, a_localID));
+	return it != formsByKey.end() ? reinterpret_cast<Form*>(it->second) : nullptr;
+}
+
+Form* MockBackend::LookupEditorID(std::string_view a_editorID)
+{
+	const auto it = formsByEditorID.find(a_editorID);
+	return it != formsByEditorID.end() ? reinterpret_cast<Form*>(it->second) : nullptr;
+}
+
+Form* MockBackend::LookupFormID(FormID a_formID)
+{
+	const auto it = formsByID.find(a_formID);
+	return it != formsByID.end() ? reinterpret_cast<Form*>(it->second) : nullptr;
+}
+
+FormType MockBackend::GetFormType(const Form* a_form)
+{
+	return Get(a_form).formType;
+}
+
+bool MockBackend::IsFormType(const Form* a_form, FormType a_formType)
+{
+	return IsDerivedFormType(Get(a_form).formType, a_formType);
+}
+
+FormID MockBackend::GetFormID(const Form* a_form)
+{
+	return Get(a_form).formID;
+}
+
+std::string MockBackend::GetIdentifier(const Form* a_form)
+{
+	const auto& form = Get(a_form);
+	if (form.editorID.size() > 1)
+		return form.editorID;
+	return std::format("{:X}|{}", form.localID, form.plugin);
+}
+
+Form* MockBackend::GetField(Form* a_form, Records::Category, Field a_field)
+{
+	return Get(a_form).fields[std::to_underlying(a_field)];
+}
+
+void MockBackend::SetField(Form* a_form, Records::Category, Field a_field, Form* a_value)
+{
+	Get(a_form).fields[std::to_underlying(a_field)] = a_value;
+}
+
+bool MockBackend::HasRegionSounds(Form* a_region)
+{
+	return Get(a_region).hasRegionSounds;
+}
+
+auto MockBackend::GetRegionSound(Form* a_region, Form* a_sound) -> std::optional<RegionSound>
+{
+	for (const auto& [sound, value] : Get(a_region).regionSounds) {
+		if (sound == a_sound)
+			return value;
+	}
+	return std::nullopt;
+}
+
+void MockBackend::SetRegionSound(Form* a_region, Form* a_sound, const RegionSound& a_value)
+{
+	auto& sounds = Get(a_region).regionSounds;
+	for (auto& [sound, value] : sounds) {
+		if (sound == a_sound) {
+			value = a_value;
+			return;
+		}
+	}
+	sounds.emplace_back(a_sound, a_value);
+}
+
+void MockBackend::RemoveRegionSound(Form* a_region, Form* a_sound)
+{
+	std::erase_if(Get(a_region).regionSounds, [a_sound](const auto& a_entry) { return a_entry.first == a_sound; });
+}
+
+void MockBackend::ShowMessage(const std::string& a_message)
+{
+	messages.emplace_back(a_message);
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Backend.h"
+#include "StringUtil.h"
+
+// In-memory forms for running the loader without the game, fields and region sounds are plain values
+class MockBackend : public Backend
+{
+public:
+	// Plugins are loaded in the order they are added. The first 254 give their index as the top byte of their forms' FormIDs,
+	// forms of later plugins are numbered in the FE range instead, so that every form keeps a FormID of its own.
+	void AddPlugin(std::string_view a_plugin);
+	// Stands in for a plugin changed in place, which changes the load order hash but not the load order
+	void UpdatePlugin(std::string_view a_plugin);
+	// Adds the plugin if needed, forms whose type has fields start with all of them cleared
+	Form* AddForm(FormType a_formType, std::string_view a_plugin, FormID a_localID, std::string_view a_editorID = {});
+	// Regions are added with sound data, a region without it cannot be given sounds
+	void SetHasRegionSounds(Form* a_region, bool a_hasSounds);
+
+	std::size_t GetFormCount() const { return forms.size(); }
+	std::size_t GetMessageCount() const { return messages.size(); }
+	std::span<const std::string> GetMessages() const { return messages; }
+
+	std::vector<std::string> GetPlugins() override;
+	bool IsPluginLoaded(std::string_view a_plugin) override;
+	std::uint64_t GetLoadOrderHash() override;
+
+	Form* LookupForm(std::string_view a_plugin, FormID a_localID) override;
+	Form* LookupEditorID(std::string_view a_editorID) override;
+	Form* LookupFormID(FormID a_formID) override;
+
+	FormType GetFormType(const Form* a_form) override;
+	bool IsFormType(const Form* a_form, FormType a_formType) override;
+	FormID GetFormID(const Form* a_form) override;
+	std::string GetIdentifier(const Form* a_form) override;
+
+	Form* GetField(Form* a_form, Records::Category a_category, Field a_field) override;
+	void SetField(Form* a_form, Records::Category a_category, Field a_field, Form* a_value) override;
+
+	bool HasRegionSounds(Form* a_region) override;
+	std::optional<RegionSound> GetRegionSound(Form* a_region, Form* a_sound) override;
+	void SetRegionSound(Form* a_region, Form* a_sound, const RegionSound& a_value) override;
+	void CommitRegionSounds() override {}
+	void RemoveRegionSound(Form* a_region, Form* a_sound) override;
+
+	void ShowMessage(const std::string& a_message) override;
+
+private:
+	struct MockForm
+	{
+		FormID formID;
+		FormID localID;
+		FormType formType;
+		std::string plugin;
+		std::string editorID;
+		std::array<Form*, std::to_underlying(Field::kTotal)> fields{};
+		bool hasRegionSounds = false;
+		std::vector<std::pair<Form*, RegionSound>> regionSounds;
+	};
+
+	static MockForm& Get(Form* a_form) { return *reinterpret_cast<MockForm*>(a_form); }
+	static const MockForm& Get(const Form* a_form) { return *reinterpret_cast<const MockForm*>(a_form); }
+	// Plugin index and local ID, wide enough for any number of plugins
+	static std::uint64_t GetKey(std::uint32_t a_index, FormID a_localID) { return static_cast<std::uint64_t>(a_index) << 32 | (a_localID & 0xFFFFFF); }
+
+	std::vector<std::string> plugins;
+	// Bumped by UpdatePlugin, in load order
+	std::vector<std::uint32_t> pluginVersions;
+	StringUtil::CaseInsensitiveMap<std::uint32_t> pluginIndices;
+	// Deque so that handed out forms never move
+	std::deque<MockForm> forms;
+	std::unordered_map<std::uint64_t, MockForm*> formsByKey;
+	std::unordered_map<FormID, MockForm*> formsByID;
+	FormID nextHighFormID = 0xFE000000;
+	StringUtil::CaseInsensitiveMap<MockForm*> formsByEditorID;
+	std::vector<std::string> messages;
+};
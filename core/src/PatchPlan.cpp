@@ -0,0 +1,191 @@
+#include "PatchPlan.h"
+
+std::uint32_t PatchPlan::Intern(std::string_view a_identifier)
+{
+	if (auto it = identifierIndices.find(a_identifier); it != identifierIndices.end())
+		return it->second;
+	const auto index = static_cast<std::uint32_t>(identifiers.size());
+	identifierIndices.emplace(identifiers.emplace_back(a_identifier), index);
+	return index;
+}
+
+std::optional<std::string_view> PatchPlan::GetIdentifier(std::uint32_t a_identifier) const
+{
+	if (a_identifier >= identifiers.size())
+		return std::nullopt;
+	return identifiers[a_identifier];
+}
+
+void PatchPlan::SetFileRank(std::uint32_t a_file, std::uint32_t a_rank)
+{
+	if (a_file >= ranks.size()) {
+		const auto size = ranks.size();
+		ranks.resize(a_file + 1);
+		std::iota(ranks.begin() + size, ranks.end(), static_cast<std::uint32_t>(size));
+	}
+	ranks[a_file] = a_rank;
+}
+
+void PatchPlan::AddField(Form* a_form, Records::Category a_category, const Records::FieldInfo& a_field, std::uint32_t a_file, std::optional<std::string_view> a_identifier)
+{
+	auto [it, inserted] = fieldIndices.try_emplace({ a_form, a_field.field }, static_cast<std::uint32_t>(fields.size()));
+	if (inserted)
+		fields.push_back({ a_form, a_category, a_field.field, a_field.valueType, false, std::nullopt, {} });
+
+	auto& entry = fields[it->second];
+	InsertWrite(entry.writes, { a_file, a_identifier ? Intern(*a_identifier) : NONE });
+	if (!entry.dirty) {
+		entry.dirty = true;
+		dirtyFields.push_back(it->second);
+	}
+}
+
+bool PatchPlan::AddRegionSound(Form* a_region, Form* a_sound, std::uint32_t a_file, std::optional<std::uint32_t> a_flags, std::optional<float> a_chance)
+{
+	const RegionSoundKey key{ a_region, a_sound };
+	auto [it, inserted] = regionSoundIndices.try_emplace(key, static_cast<std::uint32_t>(regionSounds.size()));
+	if (inserted)
+		regionSounds.push_back({ key, false, false, std::nullopt, {} });
+
+	auto& entry = regionSounds[it->second];
+	const bool first = entry.writes.empty();
+	InsertWrite(entry.writes, { a_file, a_flags, a_chance });
+	if (!entry.dirty) {
+		entry.dirty = true;
+		dirtyRegionSounds.push_back(it->second);
+	}
+	return first;
+}
+
+void PatchPlan::RemoveFiles(std::span<const std::uint32_t> a_files)
+{
+	std::vector<bool> removed;
+	for (const auto file : a_files) {
+		if (file >= removed.size())
+			removed.resize(file + 1);
+		removed[file] = true;
+	}
+	const auto isRemoved = [&](const auto& a_write) { return a_write.file < removed.size() && removed[a_write.file]; };
+
+	for (std::uint32_t i = 0; i < fields.size(); i++) {
+		auto& entry = fields[i];
+		if (std::erase_if(entry.writes, isRemoved) && !entry.dirty) {
+			entry.dirty = true;
+			dirtyFields.push_back(i);
+		}
+	}
+	for (std::uint32_t i = 0; i < regionSounds.size(); i++) {
+		auto& entry = regionSounds[i];
+		if (std::erase_if(entry.writes, isRemoved) && !entry.dirty) {
+			entry.dirty = true;
+			dirtyRegionSounds.push_back(i);
+		}
+	}
+}
+
+auto PatchPlan::Commit(const Resolver& a_resolver, Backend& a_backend) -> Stats
+{
+	Stats stats;
+	stats.fields = dirtyFields.size() + dirtyRegionSounds.size();
+	for (const auto index : dirtyFields) {
+		auto& entry = fields[index];
+		entry.dirty = false;
+		stats.writes += entry.writes.size();
+
+		// A write whose identifier does not exist never happened, so the one before it stands
+		Form* value = nullptr;
+		bool resolved = false;
+		for (auto write = entry.writes.rbegin(); !resolved && write != entry.writes.rend(); ++write)
+			resolved = a_resolver(*write, entry.category, entry.valueType, value);
+		if (!resolved) {
+			if (!entry.writes.empty())
+				stats.failed++;
+			// With nothing left to write, a field an earlier commit changed goes back to its original value
+			if (!entry.original)
+				continue;
+			value = *entry.original;
+		}
+
+		const auto current = a_backend.GetField(entry.form, entry.category, entry.field);
+		if (current == value) {
+			stats.unchanged++;
+			continue;
+		}
+		if (!entry.original)
+			entry.original = current;
+		a_backend.SetField(entry.form, entry.category, entry.field, value);
+		if (resolved) {
+			stats.applied++;
+			stats.categoryApplied[std::to_underlying(entry.category)]++;
+		} else {
+			stats.reverted++;
+		}
+	}
+	dirtyFields.clear();
+
+	for (const auto index : dirtyRegionSounds) {
+		auto& entry = regionSounds[index];
+		entry.dirty = false;
+		stats.writes += entry.writes.size();
+
+		const auto current = a_backend.GetRegionSound(entry.key.region, entry.key.sound);
+		if (!entry.journaled) {
+			entry.original = current;
+			entry.journaled = true;
+		}
+
+		if (entry.writes.empty()) {
+			if (!current)
+				continue;
+			if (!entry.original) {
+				a_backend.RemoveRegionSound(entry.key.region, entry.key.sound);
+				stats.reverted++;
+				continue;
+			}
+		}
+
+		// Later writes override only what they set, the rest falls back to the original value or the defaults of a new sound
+		std::optional<std::uint32_t> flags;
+		std::optional<float> chance;
+		for (auto write = entry.writes.rbegin(); write != entry.writes.rend() && (!flags || !chance); ++write) {
+			if (!flags)
+				flags = write->flags;
+			if (!chance)
+				chance = write->chance;
+		}
+		const auto& original = entry.original;
+		const Backend::RegionSound value{
+			flags.value_or(original ? original->flags : Records::REGION_SOUND_DEFAULT_FLAGS),
+			chance.value_or(original ? original->chance : Records::REGION_SOUND_DEFAULT_CHANCE)
+		};
+
+		if (current && current->flags == value.flags && current->chance == value.chance) {
+			stats.unchanged++;
+			continue;
+		}
+		a_backend.SetRegionSound(entry.key.region, entry.key.sound, value);
+		if (entry.writes.empty()) {
+			stats.reverted++;
+			continue;
+		}
+		stats.applied++;
+		stats.categoryApplied[std::to_underlying(Records::Category::kRegions)]++;
+		if (!current)
+			stats.added++;
+	}
+	dirtyRegionSounds.clear();
+	return stats;
+}
+
+void PatchPlan::Clear()
+{
+	ranks.clear();
+	fields.clear();
+	fieldIndices.clear();
+	regionSounds.clear();
+	regionSoundIndices.clear();
+	dirtyFields.clear();
+	dirtyRegionSounds.clear();
+	identifiers.clear();
+	identifierIndices.clear();
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include "Backend.h"
+
+// Folds every config into the final value of each (form, field) before anything is written.
+// Identifiers are kept unresolved until Commit, which resolves and writes only the last writer
+// of each field, falling back to earlier writers if its identifier does not exist. Missing identifiers
+// are reported for every writer before planning, the resolver only decides which value is written.
+// The value each field had before its first write is kept, so that the writes of some files can be
+// taken out again and the affected fields recommitted, which is how configs are reloaded.
+class PatchPlan
+{
+public:
+	static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+	struct Write
+	{
+		std::uint32_t file;
+		// NONE for an explicit null, which clears the field
+		std::uint32_t identifier;
+	};
+
+	// Resolves one write, returns false if its identifier does not exist
+	using Resolver = std::function<bool(const Write& a_write, Records::Category a_category, FormType a_formType, Form*& a_value)>;
+
+	struct Stats
+	{
+		std::size_t fields = 0;
+		std::size_t writes = 0;
+		std::size_t applied = 0;
+		std::size_t unchanged = 0;
+		std::size_t failed = 0;
+		std::size_t added = 0;
+		// Fields and region sounds put back to their original value because nothing writes them anymore
+		std::size_t reverted = 0;
+		// Applied writes of each category, region sounds count as regions
+		std::array<std::size_t, std::to_underlying(Records::Category::kTotal)> categoryApplied{};
+	};
+
+	// Writes are ordered by the rank of their file, a file without one ranks by its index
+	void SetFileRank(std::uint32_t a_file, std::uint32_t a_rank);
+
+	void AddField(Form* a_form, Records::Category a_category, const Records::FieldInfo& a_field, std::uint32_t a_file, std::optional<std::string_view> a_identifier);
+
+	// Returns true for the first write to this region sound in the plan
+	bool AddRegionSound(Form* a_region, Form* a_sound, std::uint32_t a_file, std::optional<std::uint32_t> a_flags, std::optional<float> a_chance);
+
+	// Drops every write of the given files, the fields they wrote are recommitted by the next Commit
+	void RemoveFiles(std::span<const std::uint32_t> a_files);
+
+	std::optional<std::string_view> GetIdentifier(std::uint32_t a_identifier) const;
+
+	// Writes every value changed since the last Commit through a_backend, added region sounds still need its CommitRegionSounds
+	Stats Commit(const Resolver& a_resolver, Backend& a_backend);
+	void Clear();
+
+private:
+	struct FieldKey
+	{
+		Form* form;
+		Field field;
+
+		bool operator==(const FieldKey&) const = default;
+	};
+
+	struct FieldKeyHash
+	{
+		std::size_t operator()(const FieldKey& a_key) const
+		{
+			return std::hash<Form*>{}(a_key.form) ^ (static_cast<std::size_t>(a_key.field) << 1);
+		}
+	};
+
+	struct FieldEntry
+	{
+		Form* form;
+		Records::Category category;
+		Field field;
+		FormType valueType;
+		bool dirty;
+		// Value before the first commit that changed it
+		std::optional<Form*> original;
+		// Every writer in load order, the last one wins
+		std::vector<Write> writes;
+	};
+
+	struct RegionSoundKey
+	{
+		Form* region;
+		Form* sound;
+
+		bool operator==(const RegionSoundKey&) const = default;
+	};
+
+	struct RegionSoundKeyHash
+	{
+		std::size_t operator()(const RegionSoundKey& a_key) const
+		{
+			return std::hash<Form*>{}(a_key.region) ^ (std::hash<Form*>{}(a_key.sound) << 1);
+		}
+	};
+
+	struct RegionSoundWrite
+	{
+		std::uint32_t file;
+		std::optional<std::uint32_t> flags;
+		std::optional<float> chance;
+	};
+
+	struct RegionSoundEntry
+	{
+		RegionSoundKey key;
+		bool dirty;
+		// Whether original holds the value before the first commit, a nullopt original is a sound the plan added
+		bool journaled;
+		std::optional<Backend::RegionSound> original;
+		std::vector<RegionSoundWrite> writes;
+	};
+
+	std::uint32_t Intern(std::string_view a_identifier);
+	std::uint32_t GetRank(std::uint32_t a_file) const { return a_file < ranks.size() ? ranks[a_file] : a_file; }
+
+	// Inserts after every write of a file with a lower or equal rank, which is an append while files are planned in order
+	template <class T>
+	void InsertWrite(std::vector<T>& a_writes, const T& a_write)
+	{
+		if (a_writes.empty() || GetRank(a_writes.back().file) <= GetRank(a_write.file)) {
+			a_writes.push_back(a_write);
+			return;
+		}
+		const auto it = std::ranges::upper_bound(a_writes, GetRank(a_write.file), {}, [this](const T& a_entry) { return GetRank(a_entry.file); });
+		a_writes.insert(it, a_write);
+	}
+
+	std::vector<std::uint32_t> ranks;
+
+	std::vector<FieldEntry> fields;
+	std::unordered_map<FieldKey, std::uint32_t, FieldKeyHash> fieldIndices;
+	std::vector<RegionSoundEntry> regionSounds;
+	std::unordered_map<RegionSoundKey, std::uint32_t, RegionSoundKeyHash> regionSoundIndices;
+	// Entries changed since the last Commit
+	std::vector<std::uint32_t> dirtyFields;
+	std::vector<std::uint32_t> dirtyRegionSounds;
+
+	// Indices view into identifiers owned by this deque, which never moves its elements
+	std::deque<std::string> identifiers;
+	std::unordered_map<std::string_view, std::uint32_t> identifierIndices;
+};
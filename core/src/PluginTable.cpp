@@ -0,0 +1,167 @@
+#include "PluginTable.h"
+
+namespace
+{
+	constexpr std::array<std::string_view, 3> GROUP_NAMES{
+		"All"sv,
+		"Any"sv,
+		"None"sv
+	};
+}
+
+PluginTable::PluginTable(std::span<const std::string> a_loaded)
+{
+	for (const auto& plugin : a_loaded) {
+		const auto index = Intern(plugin);
+		bits[index / 64] |= 1ull << (index % 64);
+	}
+}
+
+std::uint32_t PluginTable::Intern(std::string_view a_plugin)
+{
+	if (const auto it = indices.find(a_plugin); it != indices.end())
+		return it->second;
+	const auto index = static_cast<std::uint32_t>(names.size());
+	names.emplace_back(a_plugin);
+	indices.emplace(names.back(), index);
+	if (bits.size() * 64 <= index)
+		bits.push_back(0);
+	return index;
+}
+
+auto PluginTable::Compile(const ConfigData& a_config) -> Expression
+{
+	Expression expression;
+	CompileGroup(a_config, ConfigData::RequirementGroup::kAll, 0, a_config.GetRequirements().size(), expression);
+	return expression;
+}
+
+void PluginTable::CompileGroup(const ConfigData& a_config, ConfigData::RequirementGroup a_group, std::size_t a_begin, std::size_t a_end, Expression& a_expression)
+{
+	const auto requirements = a_config.GetRequirements();
+	const auto node = a_expression.nodes.size();
+	a_expression.nodes.push_back({ a_group, static_cast<std::uint32_t>(a_expression.masks.size()), 0, 0, 0 });
+
+	// Plugins directly in the group become its masks, nested groups follow as nodes of their own
+	std::vector<std::uint32_t> loaded;
+	std::vector<std::uint32_t> absent;
+	for (auto i = a_begin; i < a_end; i++) {
+		const auto entry = requirements[i];
+		if (ConfigData::IsRequirementGroup(entry)) {
+			i += ConfigData::GetRequirementGroupSize(entry);
+			continue;
+		}
+		const auto name = a_config.GetString(entry).value_or(""sv);
+		if (name.ends_with('!'))
+			absent.push_back(Intern(name.substr(0, name.size() - 1)));
+		else
+			loaded.push_back(Intern(name));
+	}
+
+	const auto addMasks = [&](std::vector<std::uint32_t>& a_indices) {
+		std::ranges::sort(a_indices);
+		const auto first = a_expression.masks.size();
+		for (const auto index : a_indices) {
+			if (a_expression.masks.size() == first || a_expression.masks.back().word != index / 64)
+				a_expression.masks.push_back({ index / 64, 0 });
+			a_expression.masks.back().bits |= 1ull << (index % 64);
+		}
+		return static_cast<std::uint32_t>(a_expression.masks.size() - first);
+	};
+	a_expression.nodes[node].loadedMasks = addMasks(loaded);
+	a_expression.nodes[node].absentMasks = addMasks(absent);
+
+	for (auto i = a_begin; i < a_end; i++) {
+		const auto entry = requirements[i];
+		if (!ConfigData::IsRequirementGroup(entry))
+			continue;
+		const auto size = ConfigData::GetRequirementGroupSize(entry);
+		CompileGroup(a_config, ConfigData::GetRequirementGroup(entry), i + 1, i + 1 + size, a_expression);
+		i += size;
+	}
+	a_expression.nodes[node].size = static_cast<std::uint32_t>(a_expression.nodes.size() - node - 1);
+}
+
+bool PluginTable::Expression::Evaluate(const PluginTable& a_table) const
+{
+	std::size_t node = 0;
+	return nodes.empty() || EvaluateNode(a_table, node);
+}
+
+bool PluginTable::Expression::EvaluateNode(const PluginTable& a_table, std::size_t& a_node) const
+{
+	const auto& node = nodes[a_node];
+	const auto end = a_node + 1 + node.size;
+	a_node++;
+
+	const auto loaded = std::span{ masks }.subspan(node.firstMask, node.loadedMasks);
+	const auto absent = std::span{ masks }.subspan(node.firstMask + node.loadedMasks, node.absentMasks);
+	const auto allLoaded = [&](const Mask& a_mask) { return (a_table.bits[a_mask.word] & a_mask.bits) == a_mask.bits; };
+	const auto anyLoaded = [&](const Mask& a_mask) { return (a_table.bits[a_mask.word] & a_mask.bits) != 0; };
+
+	bool result;
+	if (node.group == ConfigData::RequirementGroup::kAll) {
+		result = std::ranges::all_of(loaded, allLoaded) && std::ranges::none_of(absent, anyLoaded);
+		while (result && a_node < end)
+			result = EvaluateNode(a_table, a_node);
+	} else {
+		bool any = std::ranges::any_of(loaded, anyLoaded) || !std::ranges::all_of(absent, allLoaded);
+		while (!any && a_node < end)
+			any = EvaluateNode(a_table, a_node);
+		result = node.group == ConfigData::RequirementGroup::kAny ? any : !any;
+	}
+	a_node = end;
+	return result;
+}
+
+std::vector<std::string> PluginTable::Expression::Explain(const PluginTable& a_table) const
+{
+	std::vector<std::string> entries;
+	if (nodes.empty())
+		return entries;
+
+	DescribeMasks(a_table, nodes.front(), entries, true);
+	for (std::size_t node = 1; node < nodes.size();) {
+		auto next = node;
+		if (!EvaluateNode(a_table, next))
+			entries.push_back(DescribeNode(a_table, node));
+		node = next;
+	}
+	return entries;
+}
+
+std::string PluginTable::Expression::DescribeNode(const PluginTable& a_table, std::size_t& a_node) const
+{
+	const auto& node = nodes[a_node];
+	const auto end = a_node + 1 + node.size;
+	a_node++;
+
+	std::vector<std::string> entries;
+	DescribeMasks(a_table, node, entries, false);
+	while (a_node < end)
+		entries.push_back(DescribeNode(a_table, a_node));
+
+	std::string description{ GROUP_NAMES[std::to_underlying(node.group)] };
+	description += '(';
+	for (std::size_t i = 0; i < entries.size(); i++) {
+		if (i)
+			description += ", ";
+		description += entries[i];
+	}
+	description += ')';
+	return description;
+}
+
+void PluginTable::Expression::DescribeMasks(const PluginTable& a_table, const Node& a_node, std::vector<std::string>& a_entries, bool a_failedOnly) const
+{
+	for (std::uint32_t i = 0; i < a_node.loadedMasks + a_node.absentMasks; i++) {
+		const auto& mask = masks[a_node.firstMask + i];
+		const bool absent = i >= a_node.loadedMasks;
+		for (auto bits = mask.bits; bits; bits &= bits - 1) {
+			const auto index = mask.word * 64 + static_cast<std::uint32_t>(std::countr_zero(bits));
+			if (a_failedOnly && a_table.IsLoaded(index) != absent)
+				continue;
+			a_entries.push_back(absent ? std::format("NOT {}", a_table.GetName(index)) : std::string{ a_table.GetName(index) });
+		}
+	}
+}
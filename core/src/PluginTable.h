@@ -0,0 +1,64 @@
+#pragma once
+
+#include "ConfigData.h"
+#include "StringUtil.h"
+
+// Every plugin named by the load order or by a requirement, by case-insensitive name, with a bit set for each loaded one.
+// Built once per load, so that requirements compile to masks of these bits and are checked without asking the backend.
+class PluginTable
+{
+public:
+	// A config's requirements as a tree of groups over masks of plugin bits
+	class Expression
+	{
+	public:
+		bool Evaluate(const PluginTable& a_table) const;
+		// Top-level entries that do not hold, as "Plugin.esp", "NOT Plugin.esp" or "Any(...)"
+		std::vector<std::string> Explain(const PluginTable& a_table) const;
+
+	private:
+		friend class PluginTable;
+
+		struct Mask
+		{
+			std::uint32_t word;
+			std::uint64_t bits;
+		};
+
+		struct Node
+		{
+			ConfigData::RequirementGroup group;
+			// Masks of the plugins this group needs loaded, followed by those it needs absent
+			std::uint32_t firstMask;
+			std::uint32_t loadedMasks;
+			std::uint32_t absentMasks;
+			// Nodes after this one that belong to it
+			std::uint32_t size;
+		};
+
+		bool EvaluateNode(const PluginTable& a_table, std::size_t& a_node) const;
+		std::string DescribeNode(const PluginTable& a_table, std::size_t& a_node) const;
+		void DescribeMasks(const PluginTable& a_table, const Node& a_node, std::vector<std::string>& a_entries, bool a_failedOnly) const;
+
+		std::vector<Node> nodes;
+		std::vector<Mask> masks;
+	};
+
+	PluginTable() = default;
+	explicit PluginTable(std::span<const std::string> a_loaded);
+
+	// Index of a_plugin, added as not loaded if the load order does not have it
+	std::uint32_t Intern(std::string_view a_plugin);
+	bool IsLoaded(std::uint32_t a_index) const { return (bits[a_index / 64] >> (a_index % 64)) & 1; }
+	std::string_view GetName(std::uint32_t a_index) const { return names[a_index]; }
+
+	// Plugin names ending in ! must be absent, the list itself must hold as a whole
+	Expression Compile(const ConfigData& a_config);
+
+private:
+	void CompileGroup(const ConfigData& a_config, ConfigData::RequirementGroup a_group, std::size_t a_begin, std::size_t a_end, Expression& a_expression);
+
+	StringUtil::CaseInsensitiveMap<std::uint32_t> indices;
+	std::vector<std::string> names;
+	std::vector<std::uint64_t> bits;
+};
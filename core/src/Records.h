@@ -0,0 +1,220 @@
+#pragma once
+
+#include "Fields.h"
+#include "Forms.h"
+
+// Every record category a config can patch and the fields each accepts, the parser maps keys to fields through these tables.
+// Backends implement the fields for their own records, the game backend checks its tables against these at compile time.
+namespace Records
+{
+	struct FieldInfo
+	{
+		Field field;
+		// Type of the form the field points to, kNone for plain values
+		FormType valueType;
+	};
+
+	inline constexpr std::array PICKUP_PUTDOWN_FIELDS{
+		FieldInfo{ Field::kPickUp, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kPutDown, FormType::kSoundDescriptor }
+	};
+
+	inline constexpr std::array WEAPON_FIELDS{
+		FieldInfo{ Field::kPickUp, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kPutDown, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kImpactDataSet, FormType::kImpactDataSet },
+		FieldInfo{ Field::kAttack, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kAttack2D, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kAttackLoop, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kAttackFail, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kIdle, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kEquip, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kUnequip, FormType::kSoundDescriptor }
+	};
+
+	inline constexpr std::array MAGIC_EFFECT_FIELDS{
+		FieldInfo{ Field::kSheatheDraw, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kCharge, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kReady, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kRelease, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kCastLoop, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kOnHit, FormType::kSoundDescriptor }
+	};
+
+	inline constexpr std::array ARMOR_ADDON_FIELDS{
+		FieldInfo{ Field::kFootstep, FormType::kFootstepSet }
+	};
+
+	inline constexpr std::array PROJECTILE_FIELDS{
+		FieldInfo{ Field::kActive, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kCountdown, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kDeactivate, FormType::kSoundDescriptor }
+	};
+
+	inline constexpr std::array EXPLOSION_FIELDS{
+		FieldInfo{ Field::kInterior, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kExterior, FormType::kSoundDescriptor }
+	};
+
+	inline constexpr std::array EFFECT_SHADER_FIELDS{
+		FieldInfo{ Field::kAmbient, FormType::kSoundDescriptor }
+	};
+
+	inline constexpr std::array INGESTIBLE_FIELDS{
+		FieldInfo{ Field::kConsume, FormType::kSoundDescriptor }
+	};
+
+	inline constexpr std::array DOOR_FIELDS{
+		FieldInfo{ Field::kOpen, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kClose, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kLoop, FormType::kSoundDescriptor }
+	};
+
+	inline constexpr std::array CONTAINER_FIELDS{
+		FieldInfo{ Field::kOpen, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kClose, FormType::kSoundDescriptor }
+	};
+
+	inline constexpr std::array ACTIVATOR_FIELDS{
+		FieldInfo{ Field::kLoop, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kActivate, FormType::kSoundDescriptor }
+	};
+
+	// Region sounds are lists of entries keyed by "Sound" inside each record's "RDSA" array
+	inline constexpr std::array REGION_SOUND_FIELDS{
+		FieldInfo{ Field::kSound, FormType::kSoundDescriptor },
+		FieldInfo{ Field::kFlags, FormType::kNone },
+		FieldInfo{ Field::kChance, FormType::kNone }
+	};
+
+	// Bits of a region sound's "Flags", the same as the game's
+	enum class RegionSoundFlag : std::uint32_t
+	{
+		kNone = 0,
+		kPleasant = 1 << 0,
+		kCloudy = 1 << 1,
+		kRainy = 1 << 2,
+		kSnowy = 1 << 3
+	};
+
+	// Given to region sounds a config adds without setting them
+	inline constexpr std::uint32_t REGION_SOUND_DEFAULT_FLAGS = std::to_underlying(RegionSoundFlag::kPleasant) | std::to_underlying(RegionSoundFlag::kCloudy) | std::to_underlying(RegionSoundFlag::kRainy) | std::to_underlying(RegionSoundFlag::kSnowy);
+	inline constexpr float REGION_SOUND_DEFAULT_CHANCE = 0.05f;
+
+	enum class Category : std::uint8_t
+	{
+		kRegions,
+		kWeapons,
+		kMagicEffects,
+		kArmorAddons,
+		kArmors,
+		kMiscItems,
+		kSoulGems,
+		kProjectiles,
+		kExplosions,
+		kEffectShaders,
+		kIngestibles,
+		kAmmo,
+		kBooks,
+		kKeys,
+		kDoors,
+		kContainers,
+		kActivators,
+
+		kTotal
+	};
+
+	inline constexpr std::array<std::string_view, std::to_underlying(Category::kTotal)> CATEGORY_NAMES{
+		"Regions"sv,
+		"Weapons"sv,
+		"Magic Effects"sv,
+		"Armor Addons"sv,
+		"Armors"sv,
+		"Misc. Items"sv,
+		"Soul Gems"sv,
+		"Projectiles"sv,
+		"Explosions"sv,
+		"Effect Shaders"sv,
+		"Ingestibles"sv,
+		"Ammo"sv,
+		"Books"sv,
+		"Keys"sv,
+		"Doors"sv,
+		"Containers"sv,
+		"Activators"sv
+	};
+
+	// Type of the records in each category, in Category order
+	inline constexpr std::array<FormType, std::to_underlying(Category::kTotal)> CATEGORY_FORM_TYPES{
+		FormType::kRegion,
+		FormType::kWeapon,
+		FormType::kMagicEffect,
+		FormType::kArmorAddon,
+		FormType::kArmor,
+		FormType::kMiscItem,
+		FormType::kSoulGem,
+		FormType::kProjectile,
+		FormType::kExplosion,
+		FormType::kEffectShader,
+		FormType::kIngestible,
+		FormType::kAmmo,
+		FormType::kBook,
+		FormType::kKey,
+		FormType::kDoor,
+		FormType::kContainer,
+		FormType::kActivator
+	};
+
+	// Keys each category accepts, in Category order
+	inline constexpr std::array<std::span<const FieldInfo>, std::to_underlying(Category::kTotal)> CATEGORY_FIELDS{
+		REGION_SOUND_FIELDS,
+		WEAPON_FIELDS,
+		MAGIC_EFFECT_FIELDS,
+		ARMOR_ADDON_FIELDS,
+		PICKUP_PUTDOWN_FIELDS,
+		PICKUP_PUTDOWN_FIELDS,
+		PICKUP_PUTDOWN_FIELDS,
+		PROJECTILE_FIELDS,
+		EXPLOSION_FIELDS,
+		EFFECT_SHADER_FIELDS,
+		INGESTIBLE_FIELDS,
+		PICKUP_PUTDOWN_FIELDS,
+		PICKUP_PUTDOWN_FIELDS,
+		PICKUP_PUTDOWN_FIELDS,
+		DOOR_FIELDS,
+		CONTAINER_FIELDS,
+		ACTIVATOR_FIELDS
+	};
+
+	constexpr FormType GetFormType(Category a_category)
+	{
+		return CATEGORY_FORM_TYPES[std::to_underlying(a_category)];
+	}
+
+	constexpr std::optional<Category> FindCategory(std::string_view a_key)
+	{
+		for (std::size_t i = 0; i < CATEGORY_NAMES.size(); i++) {
+			if (CATEGORY_NAMES[i] == a_key)
+				return static_cast<Category>(i);
+		}
+		return std::nullopt;
+	}
+
+	constexpr const FieldInfo* FindField(Category a_category, Field a_field)
+	{
+		for (const auto& field : CATEGORY_FIELDS[std::to_underlying(a_category)]) {
+			if (field.field == a_field)
+				return &field;
+		}
+		return nullptr;
+	}
+
+	constexpr std::optional<Field> FindCategoryField(Category a_category, std::string_view a_key)
+	{
+		for (const auto& field : CATEGORY_FIELDS[std::to_underlying(a_category)]) {
+			if (GetFieldName(field.field) == a_key)
+				return field.field;
+		}
+		return std::nullopt;
+	}
+}
@@ -0,0 +1,65 @@
+#include "Settings.h"
+
+#include <nlohmann/json.hpp>
+using json = nlohmann::json;
+
+namespace
+{
+	spdlog::level::level_enum GetLevel(const json& a_data, const char* a_key, spdlog::level::level_enum a_default)
+	{
+		const auto it = a_data.find(a_key);
+		if (it == a_data.end() || !it->is_string())
+			return a_default;
+		const auto name = it->get<std::string>();
+		const auto level = spdlog::level::from_str(name);
+		// from_str falls back to off for unknown names
+		return level != spdlog::level::off || name == "off" ? level : a_default;
+	}
+}
+
+void Settings::Load(const std::filesystem::path& a_dataDirectory)
+{
+	const auto path = a_dataDirectory / "SKSE" / "Plugins" / std::format("{}.json", Core::NAME);
+
+	std::ifstream i(path);
+	if (!i.good())
+		return;
+
+	try {
+		const auto data = json::parse(i, nullptr, true, true);
+
+		if (const auto it = data.find("Report"); it != data.end() && it->is_object()) {
+			const std::string format = it->value("Format", "None");
+			if (format == "JSON") {
+				report.format = ReportFormat::kJSON;
+			} else if (format == "CSV") {
+				report.format = ReportFormat::kCSV;
+			} else {
+				report.format = ReportFormat::kNone;
+			}
+			report.stats = it->value("Stats", report.stats);
+		}
+
+		if (const auto it = data.find("Logging"); it != data.end() && it->is_object()) {
+			logging.level = GetLevel(*it, "Level", logging.level);
+			logging.categories.fill(logging.level);
+			if (const auto categories = it->find("Categories"); categories != it->end() && categories->is_object()) {
+				for (std::size_t i = 0; i < logging.categories.size(); i++)
+					logging.categories[i] = GetLevel(*categories, Log::CATEGORY_NAMES[i].data(), logging.level);
+			}
+			logging.async = it->value("Async", logging.async);
+			logging.flushInterval = it->value("FlushInterval", logging.flushInterval);
+			logging.ringBufferSize = it->value("RingBufferSize", logging.ringBufferSize);
+			logging.ringBufferLevel = GetLevel(*it, "RingBufferLevel", logging.ringBufferLevel);
+		}
+
+		if (const auto it = data.find("HotReload"); it != data.end() && it->is_object()) {
+			hotReload.enabled = it->value("Enabled", hotReload.enabled);
+			hotReload.watch = it->value("Watch", hotReload.watch);
+			hotReload.debounce = it->value("Debounce", hotReload.debounce);
+			hotReload.interval = it->value("Interval", hotReload.interval);
+		}
+	} catch (const std::exception& exc) {
+		loadError = std::format("Failed to load settings {}\n{}", path.string(), exc.what());
+	}
+}
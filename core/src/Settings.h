@@ -0,0 +1,70 @@
+#pragma once
+
+#include "Log.h"
+
+class Settings
+{
+public:
+	static Settings* GetSingleton()
+	{
+		static Settings singleton;
+		return &singleton;
+	}
+
+	enum class ReportFormat
+	{
+		kNone,
+		kJSON,
+		kCSV
+	};
+
+	struct Report
+	{
+		// Machine-readable conflict file written next to the log
+		ReportFormat format = ReportFormat::kNone;
+		// Per-phase, per-file and per-category statistics of the load, written next to the log as JSON
+		bool stats = false;
+	};
+
+	struct Logging
+	{
+#ifndef NDEBUG
+		spdlog::level::level_enum level = spdlog::level::trace;
+#else
+		spdlog::level::level_enum level = spdlog::level::info;
+#endif
+		std::array<spdlog::level::level_enum, std::to_underlying(Log::Category::kTotal)> categories{
+			level, level, level, level, level
+		};
+		bool async = true;
+		// Seconds between background flushes, errors are always flushed immediately
+		std::uint32_t flushInterval = 3;
+		// Messages below the configured levels are kept in memory and only written out when an error is logged
+		std::size_t ringBufferSize = 256;
+		spdlog::level::level_enum ringBufferLevel = spdlog::level::debug;
+	};
+
+	struct HotReload
+	{
+		// Keeps every config's writes and the values they replaced, so that changed configs can be reloaded in game
+		bool enabled = false;
+		// Reloads on its own once configs have stopped changing for debounce milliseconds
+		bool watch = false;
+		std::uint32_t debounce = 500;
+		// Milliseconds between checks of the configs for changes
+		std::uint32_t interval = 1000;
+	};
+
+	Report report;
+	Logging logging;
+	HotReload hotReload;
+
+	// Loaded before the log exists, so any error is kept here to be logged afterwards
+	std::string loadError;
+
+	// Reads SKSE/Plugins/SoundRecordDistributor.json from the data directory
+	void Load(const std::filesystem::path& a_dataDirectory);
+
+private:
+	Settings() = default;
+};
@@ -0,0 +1,81 @@
+#pragma once
+
+namespace StringUtil
+{
+	constexpr char ToLower(char a_char)
+	{
+		return a_char >= 'A' && a_char <= 'Z' ? static_cast<char>(a_char - 'A' + 'a') : a_char;
+	}
+
+	constexpr bool EqualsInsensitive(std::string_view a_lhs, std::string_view a_rhs)
+	{
+		return std::ranges::equal(a_lhs, a_rhs, [](char a_l, char a_r) { return ToLower(a_l) == ToLower(a_r); });
+	}
+
+	// Transparent so that lookups can be made with a string_view without allocating
+	struct Hash
+	{
+		using is_transparent = void;
+
+		std::size_t operator()(std::string_view a_string) const
+		{
+			return std::hash<std::string_view>{}(a_string);
+		}
+	};
+
+	template <typename T>
+	using Map = std::unordered_map<std::string, T, Hash, std::equal_to<>>;
+
+	// Transparent so that lookups can be made with a string_view without allocating
+	struct CaseInsensitiveHash
+	{
+		using is_transparent = void;
+
+		std::size_t operator()(std::string_view a_string) const
+		{
+			// FNV-1a
+			std::size_t hash = 14695981039346656037ull;
+			for (const auto c : a_string) {
+				hash ^= static_cast<std::uint8_t>(ToLower(c));
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+	};
+
+	struct CaseInsensitiveEqual
+	{
+		using is_transparent = void;
+
+		bool operator()(std::string_view a_lhs, std::string_view a_rhs) const
+		{
+			return EqualsInsensitive(a_lhs, a_rhs);
+		}
+	};
+
+	template <typename T>
+	using CaseInsensitiveMap = std::unordered_map<std::string, T, CaseInsensitiveHash, CaseInsensitiveEqual>;
+
+	// Returns the shortest "Plugin.esp" prefix of a plugin-specific config name longer than a_offset, or an empty view if there is none
+	constexpr std::string_view GetPluginPrefix(std::string_view a_filename, std::size_t a_offset = 0)
+	{
+		for (std::size_t pos = a_offset; pos + 4 <= a_filename.size(); pos++) {
+			if (a_filename[pos] == '.' && ToLower(a_filename[pos + 1]) == 'e' && ToLower(a_filename[pos + 2]) == 's') {
+				const auto type = ToLower(a_filename[pos + 3]);
+				if (type == 'p' || type == 'm' || type == 'l')
+					return a_filename.substr(0, pos + 4);
+			}
+		}
+		return {};
+	}
+
+	// Every "Plugin.esp" prefix of a config name, shortest first. A plugin's own name may hold ".esp" or the like,
+	// so which prefix names the plugin is only known against the load order.
+	inline std::vector<std::string_view> GetPluginPrefixes(std::string_view a_filename)
+	{
+		std::vector<std::string_view> prefixes;
+		for (auto prefix = GetPluginPrefix(a_filename); !prefix.empty(); prefix = GetPluginPrefix(a_filename, prefix.size()))
+			prefixes.push_back(prefix);
+		return prefixes;
+	}
+}
@@ -0,0 +1,34 @@
+#include "ThreadPool.h"
+
+ThreadPool::ThreadPool(std::size_t a_threads)
+{
+	if (!a_threads) {
+		const auto hardware = std::thread::hardware_concurrency();
+		a_threads = hardware > 1 ? hardware - 1 : 1;
+	}
+	threads.reserve(a_threads);
+	for (std::size_t i = 0; i < a_threads; i++)
+		threads.emplace_back([this](std::stop_token a_stop) { Work(a_stop); });
+}
+
+ThreadPool::~ThreadPool()
+{
+	for (auto& thread : threads)
+		thread.request_stop();
+	condition.notify_all();
+}
+
+void ThreadPool::Work(std::stop_token a_stop)
+{
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock lock{ mutex };
+			if (!condition.wait(lock, a_stop, [this]() { return !tasks.empty(); }))
+				return;
+			task = std::move(tasks.front());
+			tasks.pop_front();
+		}
+		task();
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+class ThreadPool
+{
+public:
+	explicit ThreadPool(std::size_t a_threads = 0);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	template <typename F>
+	auto Submit(F&& a_func) -> std::future<std::invoke_result_t<F>>
+	{
+		using R = std::invoke_result_t<F>;
+		auto task = std::make_shared<std::packaged_task<R()>>(std::forward<F>(a_func));
+		auto future = task->get_future();
+		{
+			std::lock_guard lock{ mutex };
+			tasks.emplace_back([task]() { (*task)(); });
+		}
+		condition.notify_one();
+		return future;
+	}
+
+	std::size_t GetThreadCount() const { return threads.size(); }
+
+private:
+	void Work(std::stop_token a_stop);
+
+	std::mutex mutex;
+	std::condition_variable_any condition;
+	std::deque<std::function<void()>> tasks;
+	std::vector<std::jthread> threads;
+};
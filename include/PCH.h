@@ -1,5 +1,7 @@
 #pragma once
 
+#include "CorePCH.h"
+
 #pragma warning(push)
 #pragma warning(disable : 5105)
 #pragma warning(disable : 4189)
@@ -0,0 +1,38 @@
+#include "ConsoleCommand.h"
+
+#include "DataStorage.h"
+
+namespace
+{
+	// Debug leftover with no function in release builds of the game
+	constexpr auto REPLACED_COMMAND = "ToggleHeapTracking"sv;
+
+	constexpr auto LONG_NAME = "ReloadSRD";
+	constexpr auto SHORT_NAME = "srdreload";
+	constexpr auto HELP = "Reloads the _SRD configs that changed since they were applied";
+
+	bool Execute(const RE::SCRIPT_PARAMETER*, RE::SCRIPT_FUNCTION::ScriptData*, RE::TESObjectREFR*, RE::TESObjectREFR*, RE::Script*, RE::ScriptLocals*, double&, std::uint32_t&)
+	{
+		DataStorage::GetSingleton()->ReloadConfigs();
+		return true;
+	}
+}
+
+void ConsoleCommand::Install()
+{
+	const auto command = RE::SCRIPT_FUNCTION::LocateConsoleCommand(REPLACED_COMMAND);
+	if (!command) {
+		logger::warn("Failed to find console command {}, {} is unavailable", REPLACED_COMMAND, LONG_NAME);
+		return;
+	}
+
+	command->functionName = LONG_NAME;
+	command->shortName = SHORT_NAME;
+	command->helpString = HELP;
+	command->referenceFunction = false;
+	command->SetParameters();
+	command->executeFunction = Execute;
+	command->conditionFunction = nullptr;
+
+	logger::info("Registered console command {}", LONG_NAME);
+}
@@ -0,0 +1,7 @@
+#pragma once
+
+// Takes over an unused console command so that configs can be reloaded from the console
+namespace ConsoleCommand
+{
+	void Install();
+}
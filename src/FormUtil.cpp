@@ -1,33 +1,35 @@
 #include "FormUtil.h"
 
-auto FormUtil::GetFormFromIdentifier(const std::string& a_identifier) -> RE::TESForm*
+#include "Log.h"
+
+auto FormUtil::GetFormFromIdentifier(std::string_view a_plugin, RE::FormID a_localID) -> RE::TESForm*
 {
-	std::istringstream ss{ a_identifier };
-	std::string plugin, id;
+	static const auto dataHandler = RE::TESDataHandler::GetSingleton();
 
-	std::getline(ss, plugin, '|');
-	std::getline(ss, id);
-	RE::FormID relativeID;
-	std::istringstream{ id } >> std::hex >> relativeID;
-	const auto dataHandler = RE::TESDataHandler::GetSingleton();
+	auto plugin = a_plugin;
+	auto relativeID = a_localID;
 	if (g_mergeMapperInterface) {
-		const auto [mergedModName, mergedFormID] = g_mergeMapperInterface->GetNewFormID(plugin.c_str(), relativeID);
-		std::string conversion_log = "";
-		if (relativeID && mergedFormID && relativeID != mergedFormID) {
-			conversion_log = std::format("0x{:x}->0x{:x}", relativeID, mergedFormID);
-			relativeID = mergedFormID;
-		}
-		const std::string mergedModString{ mergedModName };
-		if (!(plugin.empty()) && !mergedModString.empty() && plugin != mergedModString)
-			{
-			if (conversion_log.empty())
-				conversion_log = std::format("{}->{}", plugin, mergedModString);
-			else
-				conversion_log = std::format("{}~{}->{}", conversion_log, plugin, mergedModString);
-			plugin = mergedModName;
+		// MergeMapper wants a null terminated name, copy it to the stack rather than the heap
+		std::array<char, MAX_PATH> pluginBuffer{};
+		if (plugin.size() < pluginBuffer.size()) {
+			std::ranges::copy(plugin, pluginBuffer.begin());
+			const auto [mergedModName, mergedFormID] = g_mergeMapperInterface->GetNewFormID(pluginBuffer.data(), relativeID);
+			std::string conversion_log = "";
+			if (relativeID && mergedFormID && relativeID != mergedFormID) {
+				conversion_log = std::format("0x{:x}->0x{:x}", relativeID, mergedFormID);
+				relativeID = mergedFormID;
+			}
+			const std::string_view mergedModString{ mergedModName ? mergedModName : "" };
+			if (!plugin.empty() && !mergedModString.empty() && plugin != mergedModString) {
+				if (conversion_log.empty())
+					conversion_log = std::format("{}->{}", plugin, mergedModString);
+				else
+					conversion_log = std::format("{}~{}->{}", conversion_log, plugin, mergedModString);
+				plugin = mergedModString;
+			}
+			if (!conversion_log.empty())
+				Log::Get(Log::Category::kResolve).debug("\t\tFound merged: {}", conversion_log);
 		}
-		if (!conversion_log.empty())
-			logger::debug("\t\tFound merged: {}", conversion_log);
 	}
 	return dataHandler ? dataHandler->LookupForm(relativeID, plugin) : nullptr;
 }
@@ -2,6 +2,8 @@
 
 namespace FormUtil
 {
-	auto GetFormFromIdentifier(const std::string& a_identifier) -> RE::TESForm*;
+	// Looks up a form by plugin and local FormID, following MergeMapper if it is installed
+	auto GetFormFromIdentifier(std::string_view a_plugin, RE::FormID a_localID) -> RE::TESForm*;
+
 	auto GetIdentifierFromForm(const RE::TESForm* a_form) -> std::string;
 }
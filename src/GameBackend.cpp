@@ -0,0 +1,153 @@
+#include "GameBackend.h"
+
+#include "ConfigCache.h"
+#include "FormUtil.h"
+#include "GameRecords.h"
+
+static_assert(std::to_underlying(Records::RegionSoundFlag::kPleasant) == std::to_underlying(RE::TESRegionDataSound::Sound::Flag::kPleasant));
+static_assert(std::to_underlying(Records::RegionSoundFlag::kCloudy) == std::to_underlying(RE::TESRegionDataSound::Sound::Flag::kCloudy));
+static_assert(std::to_underlying(Records::RegionSoundFlag::kRainy) == std::to_underlying(RE::TESRegionDataSound::Sound::Flag::kRainy));
+static_assert(std::to_underlying(Records::RegionSoundFlag::kSnowy) == std::to_underlying(RE::TESRegionDataSound::Sound::Flag::kSnowy));
+
+std::vector<std::string> GameBackend::GetPlugins()
+{
+	const auto dataHandler = RE::TESDataHandler::GetSingleton();
+	// Without the compiled file collection IsPluginLoaded scans every file, so the same test is made on each file directly
+	const bool scan = REL::Module::IsVR() && !dataHandler->VRcompiledFileCollection;
+	std::vector<std::string> plugins;
+	for (const auto file : dataHandler->files) {
+		const auto pluginname = file->GetFilename();
+		if (scan ? (g_mergeMapperInterface || file->GetCompileIndex() != 255) : IsPluginLoaded(pluginname))
+			plugins.emplace_back(pluginname);
+	}
+	return plugins;
+}
+
+bool GameBackend::IsPluginLoaded(std::string_view a_plugin)
+{
+	static const auto dataHandler = RE::TESDataHandler::GetSingleton();
+	if (REL::Module::IsVR() && !dataHandler->VRcompiledFileCollection) { // SkyrimVR ESL support check
+		auto& files = dataHandler->files;
+		for (const auto file : files) {
+			if (file->GetFilename() == a_plugin && ((g_mergeMapperInterface) || file->GetCompileIndex() != 255))  // merged mods, will be index 255.
+				return true;
+		}
+		return false;
+	}
+	return dataHandler->GetLoadedModIndex(a_plugin) || dataHandler->GetLoadedLightModIndex(a_plugin);
+}
+
+std::uint64_t GameBackend::GetLoadOrderHash()
+{
+	// Only what the data handler already holds, checking every plugin on disk costs more than the cache saves under a virtual filesystem.
+	// The size and write time it found each plugin with still tell a plugin updated in place from the one the cache was built with.
+	std::uint64_t hash = ConfigCache::Hash({});
+	for (auto file : RE::TESDataHandler::GetSingleton()->files) {
+		const auto pluginname = file->GetFilename();
+		const auto& fileData = file->fileData;
+		const std::array<std::uint32_t, 5> stamp{
+			file->GetCompileIndex() << 16 | file->GetSmallFileCompileIndex(),
+			fileData.nFileSizeLow,
+			fileData.nFileSizeHigh,
+			fileData.ftLastWriteTime.dwLowDateTime,
+			fileData.ftLastWriteTime.dwHighDateTime
+		};
+		hash = ConfigCache::Hash(pluginname, hash);
+		hash = ConfigCache::Hash({ reinterpret_cast<const char*>(stamp.data()), sizeof(stamp) }, hash);
+	}
+	return hash;
+}
+
+Form* GameBackend::LookupForm(std::string_view a_plugin, FormID a_localID)
+{
+	return ToForm(FormUtil::GetFormFromIdentifier(a_plugin, a_localID));
+}
+
+Form* GameBackend::LookupEditorID(std::string_view a_editorID)
+{
+	return ToForm(RE::TESForm::LookupByEditorID(a_editorID));
+}
+
+Form* GameBackend::LookupFormID(FormID a_formID)
+{
+	return ToForm(RE::TESForm::LookupByID(a_formID));
+}
+
+FormType GameBackend::GetFormType(const Form* a_form)
+{
+	return GameRecords::ToFormType(ToGameForm(a_form)->GetFormType());
+}
+
+bool GameBackend::IsFormType(const Form* a_form, FormType a_formType)
+{
+	return GameRecords::IsFormType(*ToGameForm(a_form), a_formType);
+}
+
+FormID GameBackend::GetFormID(const Form* a_form)
+{
+	return ToGameForm(a_form)->GetFormID();
+}
+
+std::string GameBackend::GetIdentifier(const Form* a_form)
+{
+	return FormUtil::GetIdentifierFromForm(ToGameForm(a_form));
+}
+
+Form* GameBackend::GetField(Form* a_form, Records::Category a_category, Field a_field)
+{
+	const auto accessor = GameRecords::FindAccessor(a_category, a_field);
+	return accessor ? ToForm(accessor->get(*ToGameForm(a_form))) : nullptr;
+}
+
+void GameBackend::SetField(Form* a_form, Records::Category a_category, Field a_field, Form* a_value)
+{
+	if (const auto accessor = GameRecords::FindAccessor(a_category, a_field))
+		accessor->set(*ToGameForm(a_form), ToGameForm(a_value));
+}
+
+RE::TESRegionDataSound* GameBackend::GetSoundData(Form* a_region)
+{
+	return regionSounds.FindSoundData(static_cast<RE::TESRegion*>(ToGameForm(a_region)));
+}
+
+bool GameBackend::HasRegionSounds(Form* a_region)
+{
+	return GetSoundData(a_region) != nullptr;
+}
+
+auto GameBackend::GetRegionSound(Form* a_region, Form* a_sound) -> std::optional<RegionSound>
+{
+	const auto data = GetSoundData(a_region);
+	const auto sound = data ? regionSounds.Find(data, static_cast<RE::BGSSoundDescriptorForm*>(ToGameForm(a_sound))) : nullptr;
+	if (!sound)
+		return std::nullopt;
+	return RegionSound{ sound->flags.underlying(), sound->chance };
+}
+
+void GameBackend::SetRegionSound(Form* a_region, Form* a_sound, const RegionSound& a_value)
+{
+	const auto data = GetSoundData(a_region);
+	if (!data)
+		return;
+	bool created;
+	const auto sound = regionSounds.GetOrCreate(data, static_cast<RE::BGSSoundDescriptorForm*>(ToGameForm(a_sound)), created);
+	sound->flags = static_cast<RE::TESRegionDataSound::Sound::Flag>(a_value.flags);
+	sound->chance = a_value.chance;
+}
+
+void GameBackend::CommitRegionSounds()
+{
+	regionSounds.Commit();
+	regionSounds.Clear();
+}
+
+void GameBackend::RemoveRegionSound(Form* a_region, Form* a_sound)
+{
+	if (const auto data = GetSoundData(a_region))
+		regionSounds.Remove(data, static_cast<RE::BGSSoundDescriptorForm*>(ToGameForm(a_sound)));
+}
+
+void GameBackend::ShowMessage(const std::string& a_message)
+{
+	RE::DebugMessageBox(a_message.c_str());
+}
@@ -0,0 +1,43 @@
+#pragma once
+
+#include "Backend.h"
+#include "RegionSounds.h"
+
+// Backend over the game's forms, every Form handed to the core is a TESForm
+class GameBackend : public Backend
+{
+public:
+	static Form* ToForm(RE::TESForm* a_form) { return reinterpret_cast<Form*>(a_form); }
+	static RE::TESForm* ToGameForm(Form* a_form) { return reinterpret_cast<RE::TESForm*>(a_form); }
+	static const RE::TESForm* ToGameForm(const Form* a_form) { return reinterpret_cast<const RE::TESForm*>(a_form); }
+
+	std::vector<std::string> GetPlugins() override;
+	bool IsPluginLoaded(std::string_view a_plugin) override;
+	std::uint64_t GetLoadOrderHash() override;
+
+	Form* LookupForm(std::string_view a_plugin, FormID a_localID) override;
+	Form* LookupEditorID(std::string_view a_editorID) override;
+	Form* LookupFormID(FormID a_formID) override;
+
+	FormType GetFormType(const Form* a_form) override;
+	bool IsFormType(const Form* a_form, FormType a_formType) override;
+	FormID GetFormID(const Form* a_form) override;
+	std::string GetIdentifier(const Form* a_form) override;
+
+	Form* GetField(Form* a_form, Records::Category a_category, Field a_field) override;
+	void SetField(Form* a_form, Records::Category a_category, Field a_field, Form* a_value) override;
+
+	bool HasRegionSounds(Form* a_region) override;
+	std::optional<RegionSound> GetRegionSound(Form* a_region, Form* a_sound) override;
+	void SetRegionSound(Form* a_region, Form* a_sound, const RegionSound& a_value) override;
+	void CommitRegionSounds() override;
+	void RemoveRegionSound(Form* a_region, Form* a_sound) override;
+
+	// Must be called from the main thread
+	void ShowMessage(const std::string& a_message) override;
+
+private:
+	RE::TESRegionDataSound* GetSoundData(Form* a_region);
+
+	RegionSounds regionSounds;
+};
@@ -0,0 +1,267 @@
+#pragma once
+
+#include "Records.h"
+
+// Compile-time accessors for every field of the core's Records tables, reached through member pointers of the game's records
+namespace GameRecords
+{
+	struct FieldAccessor
+	{
+		Field field;
+		RE::FormType formType;
+		// Take the form as a TESForm so that the tables of every record type share a type
+		void (*set)(RE::TESForm& a_form, RE::TESForm* a_value);
+		RE::TESForm* (*get)(const RE::TESForm& a_form);
+	};
+
+	// Game form types in core FormType order
+	inline constexpr std::array<RE::FormType, std::to_underlying(FormType::kTotal)> FORM_TYPES{
+		RE::FormType::None,
+		RE::TESRegion::FORMTYPE,
+		RE::TESObjectWEAP::FORMTYPE,
+		RE::EffectSetting::FORMTYPE,
+		RE::TESObjectARMA::FORMTYPE,
+		RE::TESObjectARMO::FORMTYPE,
+		RE::TESObjectMISC::FORMTYPE,
+		RE::TESSoulGem::FORMTYPE,
+		RE::BGSProjectile::FORMTYPE,
+		RE::BGSExplosion::FORMTYPE,
+		RE::TESEffectShader::FORMTYPE,
+		RE::AlchemyItem::FORMTYPE,
+		RE::TESAmmo::FORMTYPE,
+		RE::TESObjectBOOK::FORMTYPE,
+		RE::TESKey::FORMTYPE,
+		RE::TESObjectDOOR::FORMTYPE,
+		RE::TESObjectCONT::FORMTYPE,
+		RE::TESObjectACTI::FORMTYPE,
+		RE::BGSSoundDescriptorForm::FORMTYPE,
+		RE::BGSImpactDataSet::FORMTYPE,
+		RE::BGSFootstepSet::FORMTYPE
+	};
+
+	constexpr RE::FormType ToGameFormType(FormType a_formType)
+	{
+		return FORM_TYPES[std::to_underlying(a_formType)];
+	}
+
+	constexpr FormType ToFormType(RE::FormType a_formType)
+	{
+		for (std::size_t i = 0; i < FORM_TYPES.size(); i++) {
+			if (FORM_TYPES[i] == a_formType)
+				return static_cast<FormType>(i);
+		}
+		return FormType::kNone;
+	}
+
+	namespace detail
+	{
+		template <class T>
+		bool Is(const RE::TESForm& a_form)
+		{
+			return a_form.As<T>() != nullptr;
+		}
+
+		template <class T, auto... Members>
+		using MemberType = std::remove_cvref_t<decltype((std::declval<T&>() .* ... .* Members))>;
+
+		template <class T, auto... Members>
+		void Set(RE::TESForm& a_form, RE::TESForm* a_value)
+		{
+			(static_cast<T&>(a_form) .* ... .* Members) = static_cast<MemberType<T, Members...>>(a_value);
+		}
+
+		template <class T, auto... Members>
+		RE::TESForm* Get(const RE::TESForm& a_form)
+		{
+			return (static_cast<const T&>(a_form) .* ... .* Members);
+		}
+
+		template <RE::MagicSystem::SoundID ID>
+		void SetEffectSound(RE::TESForm& a_form, RE::TESForm* a_value)
+		{
+			auto& effect = static_cast<RE::EffectSetting&>(a_form);
+			const auto sound = static_cast<RE::BGSSoundDescriptorForm*>(a_value);
+			for (auto& pair : effect.effectSounds) {
+				if (pair.id == ID) {
+					pair.sound = sound;
+					pair.pad04 = sound != nullptr;
+					return;
+				}
+			}
+			RE::EffectSetting::SoundPair pair;
+			pair.id = ID;
+			pair.sound = sound;
+			pair.pad04 = sound != nullptr;
+			effect.effectSounds.emplace_back(pair);
+		}
+
+		template <RE::MagicSystem::SoundID ID>
+		RE::TESForm* GetEffectSound(const RE::TESForm& a_form)
+		{
+			for (const auto& pair : static_cast<const RE::EffectSetting&>(a_form).effectSounds) {
+				if (pair.id == ID)
+					return pair.sound;
+			}
+			return nullptr;
+		}
+	}
+
+	// Type checks in core FormType order, through As so that subclasses pass too: soul gems and keys are misc items
+	inline constexpr std::array<bool (*)(const RE::TESForm&), std::to_underlying(FormType::kTotal)> FORM_CHECKS{
+		nullptr,
+		&detail::Is<RE::TESRegion>,
+		&detail::Is<RE::TESObjectWEAP>,
+		&detail::Is<RE::EffectSetting>,
+		&detail::Is<RE::TESObjectARMA>,
+		&detail::Is<RE::TESObjectARMO>,
+		&detail::Is<RE::TESObjectMISC>,
+		&detail::Is<RE::TESSoulGem>,
+		&detail::Is<RE::BGSProjectile>,
+		&detail::Is<RE::BGSExplosion>,
+		&detail::Is<RE::TESEffectShader>,
+		&detail::Is<RE::AlchemyItem>,
+		&detail::Is<RE::TESAmmo>,
+		&detail::Is<RE::TESObjectBOOK>,
+		&detail::Is<RE::TESKey>,
+		&detail::Is<RE::TESObjectDOOR>,
+		&detail::Is<RE::TESObjectCONT>,
+		&detail::Is<RE::TESObjectACTI>,
+		&detail::Is<RE::BGSSoundDescriptorForm>,
+		&detail::Is<RE::BGSImpactDataSet>,
+		&detail::Is<RE::BGSFootstepSet>
+	};
+
+	inline bool IsFormType(const RE::TESForm& a_form, FormType a_formType)
+	{
+		const auto check = FORM_CHECKS[std::to_underlying(a_formType)];
+		return check && check(a_form);
+	}
+
+	// Describes a form pointer reached from T through a chain of member pointers
+	template <class T, auto... Members>
+	constexpr FieldAccessor Describe(Field a_field)
+	{
+		using Value = std::remove_pointer_t<detail::MemberType<T, Members...>>;
+		return { a_field, Value::FORMTYPE, &detail::Set<T, Members...>, &detail::Get<T, Members...> };
+	}
+
+	// Magic effects keep their sounds in a list of (SoundID, sound) pairs instead of members
+	template <RE::MagicSystem::SoundID ID>
+	constexpr FieldAccessor DescribeEffectSound(Field a_field)
+	{
+		return { a_field, RE::BGSSoundDescriptorForm::FORMTYPE, &detail::SetEffectSound<ID>, &detail::GetEffectSound<ID> };
+	}
+
+	template <class T>
+	inline constexpr std::array PICKUP_PUTDOWN_FIELDS{
+		Describe<T, &T::pickupSound>(Field::kPickUp),
+		Describe<T, &T::putdownSound>(Field::kPutDown)
+	};
+
+	inline constexpr std::array WEAPON_FIELDS{
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::pickupSound>(Field::kPickUp),
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::putdownSound>(Field::kPutDown),
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::impactDataSet>(Field::kImpactDataSet),
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::attackSound>(Field::kAttack),
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::attackSound2D>(Field::kAttack2D),
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::attackLoopSound>(Field::kAttackLoop),
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::attackFailSound>(Field::kAttackFail),
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::idleSound>(Field::kIdle),
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::equipSound>(Field::kEquip),
+		Describe<RE::TESObjectWEAP, &RE::TESObjectWEAP::unequipSound>(Field::kUnequip)
+	};
+
+	// In SoundID order
+	inline constexpr std::array MAGIC_EFFECT_FIELDS{
+		DescribeEffectSound<static_cast<RE::MagicSystem::SoundID>(0)>(Field::kSheatheDraw),
+		DescribeEffectSound<static_cast<RE::MagicSystem::SoundID>(1)>(Field::kCharge),
+		DescribeEffectSound<static_cast<RE::MagicSystem::SoundID>(2)>(Field::kReady),
+		DescribeEffectSound<static_cast<RE::MagicSystem::SoundID>(3)>(Field::kRelease),
+		DescribeEffectSound<static_cast<RE::MagicSystem::SoundID>(4)>(Field::kCastLoop),
+		DescribeEffectSound<static_cast<RE::MagicSystem::SoundID>(5)>(Field::kOnHit)
+	};
+
+	inline constexpr std::array ARMOR_ADDON_FIELDS{
+		Describe<RE::TESObjectARMA, &RE::TESObjectARMA::footstepSet>(Field::kFootstep)
+	};
+
+	inline constexpr std::array PROJECTILE_FIELDS{
+		Describe<RE::BGSProjectile, &RE::BGSProjectile::data, &decltype(RE::BGSProjectile::data)::activeSoundLoop>(Field::kActive),
+		Describe<RE::BGSProjectile, &RE::BGSProjectile::data, &decltype(RE::BGSProjectile::data)::countdownSound>(Field::kCountdown),
+		Describe<RE::BGSProjectile, &RE::BGSProjectile::data, &decltype(RE::BGSProjectile::data)::deactivateSound>(Field::kDeactivate)
+	};
+
+	inline constexpr std::array EXPLOSION_FIELDS{
+		Describe<RE::BGSExplosion, &RE::BGSExplosion::data, &decltype(RE::BGSExplosion::data)::sound1>(Field::kInterior),
+		Describe<RE::BGSExplosion, &RE::BGSExplosion::data, &decltype(RE::BGSExplosion::data)::sound2>(Field::kExterior)
+	};
+
+	inline constexpr std::array EFFECT_SHADER_FIELDS{
+		Describe<RE::TESEffectShader, &RE::TESEffectShader::data, &decltype(RE::TESEffectShader::data)::ambientSound>(Field::kAmbient)
+	};
+
+	inline constexpr std::array INGESTIBLE_FIELDS{
+		Describe<RE::AlchemyItem, &RE::AlchemyItem::data, &decltype(RE::AlchemyItem::data)::consumptionSound>(Field::kConsume)
+	};
+
+	inline constexpr std::array DOOR_FIELDS{
+		Describe<RE::TESObjectDOOR, &RE::TESObjectDOOR::openSound>(Field::kOpen),
+		Describe<RE::TESObjectDOOR, &RE::TESObjectDOOR::closeSound>(Field::kClose),
+		Describe<RE::TESObjectDOOR, &RE::TESObjectDOOR::loopSound>(Field::kLoop)
+	};
+
+	inline constexpr std::array CONTAINER_FIELDS{
+		Describe<RE::TESObjectCONT, &RE::TESObjectCONT::openSound>(Field::kOpen),
+		Describe<RE::TESObjectCONT, &RE::TESObjectCONT::closeSound>(Field::kClose)
+	};
+
+	inline constexpr std::array ACTIVATOR_FIELDS{
+		Describe<RE::TESObjectACTI, &RE::TESObjectACTI::soundLoop>(Field::kLoop),
+		Describe<RE::TESObjectACTI, &RE::TESObjectACTI::soundActivate>(Field::kActivate)
+	};
+
+	// Accessors of each category, in Category order. Region sounds are lists rather than fields and have none.
+	inline constexpr std::array<std::span<const FieldAccessor>, std::to_underlying(Records::Category::kTotal)> CATEGORY_ACCESSORS{
+		std::span<const FieldAccessor>{},
+		WEAPON_FIELDS,
+		MAGIC_EFFECT_FIELDS,
+		ARMOR_ADDON_FIELDS,
+		PICKUP_PUTDOWN_FIELDS<RE::TESObjectARMO>,
+		PICKUP_PUTDOWN_FIELDS<RE::TESObjectMISC>,
+		PICKUP_PUTDOWN_FIELDS<RE::TESSoulGem>,
+		PROJECTILE_FIELDS,
+		EXPLOSION_FIELDS,
+		EFFECT_SHADER_FIELDS,
+		INGESTIBLE_FIELDS,
+		PICKUP_PUTDOWN_FIELDS<RE::TESAmmo>,
+		PICKUP_PUTDOWN_FIELDS<RE::TESObjectBOOK>,
+		PICKUP_PUTDOWN_FIELDS<RE::TESKey>,
+		DOOR_FIELDS,
+		CONTAINER_FIELDS,
+		ACTIVATOR_FIELDS
+	};
+
+	// Every field the core knows has an accessor of the same form type, in the same order
+	static_assert([] {
+		for (std::size_t i = 1; i < CATEGORY_ACCESSORS.size(); i++) {
+			const auto accessors = CATEGORY_ACCESSORS[i];
+			const auto fields = Records::CATEGORY_FIELDS[i];
+			if (accessors.size() != fields.size())
+				return false;
+			for (std::size_t j = 0; j < fields.size(); j++) {
+				if (accessors[j].field != fields[j].field || accessors[j].formType != ToGameFormType(fields[j].valueType))
+					return false;
+			}
+		}
+		return true;
+	}());
+
+	constexpr const FieldAccessor* FindAccessor(Records::Category a_category, Field a_field)
+	{
+		for (const auto& accessor : CATEGORY_ACCESSORS[std::to_underlying(a_category)]) {
+			if (accessor.field == a_field)
+				return &accessor;
+		}
+		return nullptr;
+	}
+}
@@ -0,0 +1,102 @@
+#include "RegionSounds.h"
+
+RE::TESRegionDataSound* RegionSounds::FindSoundData(RE::TESRegion* a_region)
+{
+	auto [it, inserted] = soundData.try_emplace(a_region, nullptr);
+	if (!inserted)
+		return it->second;
+
+	const auto regionDataManager = RE::TESDataHandler::GetSingleton()->GetRegionDataManager();
+	if (!regionDataManager || !a_region->dataList)
+		return nullptr;
+	for (auto entry : a_region->dataList->regionDataList) {
+		if (entry && entry->GetType() == RE::TESRegionData::Type::kSound) {
+			if (const auto data = regionDataManager->AsRegionDataSound(entry)) {
+				it->second = data;
+				break;
+			}
+		}
+	}
+	return it->second;
+}
+
+auto RegionSounds::GetRegion(RE::TESRegionDataSound* a_data) -> Region&
+{
+	auto [it, inserted] = regions.try_emplace(a_data);
+	auto& region = it->second;
+	if (inserted) {
+		region.sounds.reserve(a_data->sounds.size());
+		for (auto sound : a_data->sounds) {
+			if (sound)
+				region.sounds.try_emplace(sound->sound, sound);
+		}
+	}
+	return region;
+}
+
+auto RegionSounds::Find(RE::TESRegionDataSound* a_data, RE::BGSSoundDescriptorForm* a_sound) -> Sound*
+{
+	auto& sounds = GetRegion(a_data).sounds;
+	const auto it = sounds.find(a_sound);
+	return it != sounds.end() ? it->second : nullptr;
+}
+
+auto RegionSounds::GetOrCreate(RE::TESRegionDataSound* a_data, RE::BGSSoundDescriptorForm* a_sound, bool& a_created) -> Sound*
+{
+	auto& region = GetRegion(a_data);
+
+	if (const auto it = region.sounds.find(a_sound); it != region.sounds.end()) {
+		a_created = false;
+		return it->second;
+	}
+
+	a_created = true;
+	auto& sound = region.staged.emplace_back();
+	sound.sound = a_sound;
+	region.sounds.emplace(a_sound, &sound);
+	stagedCount++;
+	return &sound;
+}
+
+void RegionSounds::Commit()
+{
+	if (!stagedCount)
+		return;
+
+	for (auto& [data, region] : regions) {
+		if (region.staged.empty())
+			continue;
+		data->sounds.reserve(data->sounds.size() + static_cast<std::uint32_t>(region.staged.size()));
+		for (const auto& staged : region.staged) {
+			// Each entry comes from the game's heap on its own, as the game allocates and frees them
+			auto sound = RE::calloc<Sound>(1);
+			*sound = staged;
+			data->sounds.push_back(sound);
+			region.sounds[staged.sound] = sound;
+		}
+		region.staged.clear();
+	}
+	stagedCount = 0;
+}
+
+void RegionSounds::Remove(RE::TESRegionDataSound* a_data, RE::BGSSoundDescriptorForm* a_sound)
+{
+	auto& region = GetRegion(a_data);
+	const auto it = region.sounds.find(a_sound);
+	if (it == region.sounds.end())
+		return;
+
+	const auto entry = std::ranges::find(a_data->sounds, it->second);
+	if (entry != a_data->sounds.end()) {
+		a_data->sounds.erase(entry);
+		RE::free(it->second);
+	}
+	region.sounds.erase(it);
+}
+
+void RegionSounds::Clear()
+{
+	soundData.clear();
+	regions.clear();
+	stagedCount = 0;
+}
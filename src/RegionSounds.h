@@ -0,0 +1,40 @@
+#pragma once
+
+// Index of the sound lists of patched regions, built on first use and shared by every config in a load.
+// Existing entries are updated in place, new entries are staged and appended in one batch by Commit.
+class RegionSounds
+{
+public:
+	using Sound = RE::TESRegionDataSound::Sound;
+
+	// Resolves a region's sound data once per load, remembering regions that have none
+	RE::TESRegionDataSound* FindSoundData(RE::TESRegion* a_region);
+
+	// Returns the region's entry for a sound, including staged ones, or nullptr if it has none
+	Sound* Find(RE::TESRegionDataSound* a_data, RE::BGSSoundDescriptorForm* a_sound);
+
+	// Returns the region's entry for a sound, staging a new one if the region has none
+	Sound* GetOrCreate(RE::TESRegionDataSound* a_data, RE::BGSSoundDescriptorForm* a_sound, bool& a_created);
+
+	// Appends staged entries to their regions, reserving each region's array once
+	void Commit();
+	// Detaches a committed entry from its region and frees it, only for entries Commit added
+	void Remove(RE::TESRegionDataSound* a_data, RE::BGSSoundDescriptorForm* a_sound);
+	void Clear();
+
+	std::size_t GetStagedCount() const { return stagedCount; }
+
+private:
+	struct Region
+	{
+		std::unordered_map<RE::BGSSoundDescriptorForm*, Sound*> sounds;
+		// Deque so that pointers handed out stay valid until Commit
+		std::deque<Sound> staged;
+	};
+
+	Region& GetRegion(RE::TESRegionDataSound* a_data);
+
+	std::unordered_map<RE::TESRegion*, RE::TESRegionDataSound*> soundData;
+	std::unordered_map<RE::TESRegionDataSound*, Region> regions;
+	std::size_t stagedCount = 0;
+};
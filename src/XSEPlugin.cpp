@@ -1,9 +1,14 @@
 #include "DataStorage.h"
 #include "Hooks.h"
+#include "Log.h"
+#include "Settings.h"
 
 void MessageHandler(SKSE::MessagingInterface::Message* a_msg)
 {
 	switch (a_msg->type) {
+	case SKSE::MessagingInterface::kPostLoad:
+		DataStorage::GetSingleton()->PrefetchConfigs();
+		break;
 	case SKSE::MessagingInterface::kPostPostLoad:
 		{
 			logger::info("{:*^30}", "MERGES");
@@ -25,10 +30,10 @@ void Init()
 	SKSE::GetMessagingInterface()->RegisterListener(MessageHandler);
 }
 
-void InitializeLog()
+std::shared_ptr<spdlog::sinks::sink> CreateLogSink()
 {
 #ifndef NDEBUG
-	auto sink = std::make_shared<spdlog::sinks::msvc_sink_mt>();
+	return std::make_shared<spdlog::sinks::msvc_sink_mt>();
 #else
 	auto path = logger::log_directory();
 	if (!path) {
@@ -36,21 +41,8 @@ void InitializeLog()
 	}
 
 	*path /= std::format("{}.log"sv, Plugin::NAME);
-	auto sink = std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true);
-#endif
-
-#ifndef NDEBUG
-	const auto level = spdlog::level::trace;
-#else
-	const auto level = spdlog::level::trace;
+	return std::make_shared<spdlog::sinks::basic_file_sink_mt>(path->string(), true);
 #endif
-
-	auto log = std::make_shared<spdlog::logger>("global log"s, std::move(sink));
-	log->set_level(level);
-	log->flush_on(level);
-
-	spdlog::set_default_logger(std::move(log));
-	spdlog::set_pattern("%v");
 }
 
 EXTERN_C [[maybe_unused]] __declspec(dllexport) bool SKSEAPI SKSEPlugin_Load(const SKSE::LoadInterface* a_skse)
@@ -59,11 +51,17 @@ EXTERN_C [[maybe_unused]] __declspec(dllexport) bool SKSEAPI SKSEPlugin_Load(con
 	while (!IsDebuggerPresent()) {};
 #endif
 
-	InitializeLog();
+	const auto settings = Settings::GetSingleton();
+	settings->Load("Data");
+
+	Log::Init(CreateLogSink());
 
 	logger::info(("{} v{}"), Plugin::NAME, Plugin::VERSION);
 	logger::info("Game version : {}", a_skse->RuntimeVersion().string());
 
+	if (!settings->loadError.empty())
+		logger::error("{}", settings->loadError);
+
 	SKSE::Init(a_skse);
 
 	Init();
@@ -0,0 +1,180 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ConfigParser.h"
+
+namespace
+{
+	constexpr auto JSON_CONFIG = R"({
+	// Comments are allowed
+	"Requirements": [ "Skyrim.esm", { "Any": [ "Dawnguard.esm", "Dragonborn.esm!" ] } ],
+	"Weapons": [
+		{
+			"Form": "Skyrim.esm|0x12EB7",
+			"Pick Up": "WPNPickUpSword",
+			"Put Down": null,
+			"Unknown": { "Nested": [ 1, 2 ] }
+		}
+	],
+	"Regions": [
+		{
+			"Form": "800|Skyrim.esm",
+			"RDSA": [
+				{ "Sound": "AMBRegionWind", "Flags": "Pleasant Rainy", "Chance": 0.25 },
+				{ "Chance": 0.5, "Sound": "AMBRegionBirds" }
+			]
+		}
+	]
+})"sv;
+
+	constexpr auto YAML_CONFIG = R"(# Comments are allowed
+Requirements:
+  - Skyrim.esm
+  - Any:
+      - Dawnguard.esm
+      - Dragonborn.esm!
+Weapons:
+  - Form: "Skyrim.esm|0x12EB7"
+    Pick Up: WPNPickUpSword
+    Put Down: ~
+    Unknown:
+      Nested: [ 1, 2 ]
+Regions:
+  - Form: "800|Skyrim.esm"
+    RDSA:
+      - Sound: AMBRegionWind
+        Flags: Pleasant Rainy
+        Chance: 0.25
+      - Chance: 0.5
+        Sound: AMBRegionBirds
+)"sv;
+
+	// Every requirement, record and value with its strings looked up, so that configs with differently numbered strings compare equal
+	std::vector<std::string> Describe(const ConfigData& a_data)
+	{
+		const auto getString = [&](std::uint32_t a_string) { return std::string{ a_data.GetString(a_string).value_or("null"sv) }; };
+
+		std::vector<std::string> lines;
+		for (const auto entry : a_data.GetRequirements()) {
+			if (ConfigData::IsRequirementGroup(entry))
+				lines.push_back(std::format("group {} of {}", std::to_underlying(ConfigData::GetRequirementGroup(entry)), ConfigData::GetRequirementGroupSize(entry)));
+			else
+				lines.push_back(getString(entry));
+		}
+		for (std::size_t i = 0; i < std::to_underlying(Records::Category::kTotal); i++) {
+			for (const auto& record : a_data.GetRecords(static_cast<Records::Category>(i))) {
+				lines.push_back(std::format("{}: {}", Records::CATEGORY_NAMES[i], getString(record.form)));
+				for (const auto& value : a_data.GetValues(record)) {
+					if (value.field == Field::kFlags || value.field == Field::kChance)
+						lines.push_back(std::format("  {} = {:X}", std::to_underlying(value.field), value.data));
+					else
+						lines.push_back(std::format("  {} = {}", std::to_underlying(value.field), getString(value.data)));
+				}
+			}
+		}
+		return lines;
+	}
+}
+
+TEST_CASE("ParseJSON reads requirements, fields and region sounds", "[parser]")
+{
+	ConfigData data;
+	ConfigParser::ParseJSON(JSON_CONFIG, data);
+
+	const auto requirements = data.GetRequirements();
+	REQUIRE(requirements.size() == 4);
+	CHECK(data.GetString(requirements[0]) == "Skyrim.esm"sv);
+	REQUIRE(ConfigData::IsRequirementGroup(requirements[1]));
+	CHECK(ConfigData::GetRequirementGroup(requirements[1]) == ConfigData::RequirementGroup::kAny);
+	CHECK(ConfigData::GetRequirementGroupSize(requirements[1]) == 2);
+	CHECK(data.GetString(requirements[3]) == "Dragonborn.esm!"sv);
+
+	CHECK(data.GetRecordCount() == 2);
+
+	const auto weapons = data.GetRecords(Records::Category::kWeapons);
+	REQUIRE(weapons.size() == 1);
+	CHECK(data.GetString(weapons[0].form) == "Skyrim.esm|0x12EB7"sv);
+	const auto weaponValues = data.GetValues(weapons[0]);
+	REQUIRE(weaponValues.size() == 2);
+	CHECK(weaponValues[0].field == Field::kPickUp);
+	CHECK(data.GetString(weaponValues[0].data) == "WPNPickUpSword"sv);
+	CHECK(weaponValues[1].field == Field::kPutDown);
+	CHECK(weaponValues[1].data == ConfigData::NONE);
+
+	const auto regions = data.GetRecords(Records::Category::kRegions);
+	REQUIRE(regions.size() == 1);
+	const auto regionValues = data.GetValues(regions[0]);
+	REQUIRE(regionValues.size() == 5);
+	CHECK(regionValues[0].field == Field::kSound);
+	CHECK(data.GetString(regionValues[0].data) == "AMBRegionWind"sv);
+	CHECK(regionValues[1].field == Field::kFlags);
+	CHECK(regionValues[1].data == (std::to_underlying(Records::RegionSoundFlag::kPleasant) | std::to_underlying(Records::RegionSoundFlag::kRainy)));
+	CHECK(regionValues[2].field == Field::kChance);
+	CHECK(std::bit_cast<float>(regionValues[2].data) == 0.25f);
+	// Keys of an entry may come in any order, the sound is always first
+	CHECK(regionValues[3].field == Field::kSound);
+	CHECK(data.GetString(regionValues[3].data) == "AMBRegionBirds"sv);
+	CHECK(regionValues[4].field == Field::kChance);
+	CHECK(std::bit_cast<float>(regionValues[4].data) == 0.5f);
+}
+
+TEST_CASE("ParseYAML matches ParseJSON", "[parser]")
+{
+	ConfigData json;
+	ConfigParser::ParseJSON(JSON_CONFIG, json);
+	ConfigData yaml;
+	ConfigParser::ParseYAML(YAML_CONFIG, yaml);
+
+	CHECK(Describe(yaml) == Describe(json));
+}
+
+TEST_CASE("ParseYAML falls back to the document for aliases", "[parser]")
+{
+	constexpr auto config = R"(Weapons:
+  - Form: &sword "Skyrim.esm|0x12EB7"
+    Pick Up: WPNPickUpSword
+  - Form: *sword
+    Put Down: WPNPutDownSword
+)"sv;
+
+	ConfigData data;
+	ConfigParser::ParseYAML(config, data);
+
+	const auto weapons = data.GetRecords(Records::Category::kWeapons);
+	REQUIRE(weapons.size() == 2);
+	CHECK(data.GetString(weapons[0].form) == "Skyrim.esm|0x12EB7"sv);
+	CHECK(data.GetString(weapons[1].form) == "Skyrim.esm|0x12EB7"sv);
+}
+
+TEST_CASE("Malformed configs throw", "[parser]")
+{
+	ConfigData data;
+	CHECK_THROWS(ConfigParser::ParseJSON(R"({ "Weapons": [ { "Form": "A", )"sv, data));
+
+	data = {};
+	CHECK_THROWS_AS(ConfigParser::ParseJSON(R"({ "Weapons": [ { "Form": "A", "Pick Up": 5 } ] })"sv, data), std::invalid_argument);
+
+	data = {};
+	CHECK_THROWS_AS(ConfigParser::ParseJSON(R"({ "Requirements": [ { "Some": [ "A.esp" ] } ] })"sv, data), std::invalid_argument);
+
+	data = {};
+	CHECK_THROWS_AS(ConfigParser::ParseYAML("Regions:\n  - Form: A\n    RDSA:\n      - Sound: B\n        Chance: often\n"sv, data), std::invalid_argument);
+}
+
+TEST_CASE("ConfigData survives serialization", "[parser]")
+{
+	ConfigData data;
+	ConfigParser::ParseJSON(JSON_CONFIG, data);
+
+	std::vector<std::uint8_t> buffer;
+	data.Serialize(buffer);
+
+	ConfigData copy;
+	REQUIRE(copy.Deserialize(buffer));
+	CHECK(Describe(copy) == Describe(data));
+
+	// A truncated buffer is rejected and leaves nothing behind
+	buffer.pop_back();
+	ConfigData truncated;
+	CHECK_FALSE(truncated.Deserialize(buffer));
+	CHECK(truncated.GetRecordCount() == 0);
+}
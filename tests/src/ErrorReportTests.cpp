@@ -0,0 +1,42 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ErrorReport.h"
+
+TEST_CASE("ErrorReport counts repeated errors once per file", "[errors]")
+{
+	spdlog::set_level(spdlog::level::off);
+	using Kind = ErrorReport::Kind;
+
+	ErrorReport errors;
+	CHECK(errors.Flush().empty());
+
+	for (std::size_t i = 0; i < 3; i++)
+		errors.Add(Kind::kMissingForm, "A_SRD.json"sv, "Form SoundA of SNDR does not exist"sv);
+	errors.Add(Kind::kBadFile, "B_SRD.json"sv, "Failed to parse B_SRD.json"sv);
+	errors.Add(Kind::kMissingForm, "B_SRD.json"sv, "Form SoundA of SNDR does not exist"sv);
+
+	const auto summary = errors.Flush();
+	CHECK(summary.starts_with(std::format("{} found 5 problems in 2 configs\n", Core::NAME)));
+	CHECK(summary.contains("\n1 unreadable configs"sv));
+	CHECK(summary.contains("\n4 missing forms"sv));
+	CHECK(summary.contains("\nA_SRD.json: 3\nB_SRD.json: 2"sv));
+	CHECK_FALSE(summary.contains("more"sv));
+
+	// Flushing starts over
+	CHECK(errors.Flush().empty());
+}
+
+TEST_CASE("ErrorReport lists the files with the most errors", "[errors]")
+{
+	spdlog::set_level(spdlog::level::off);
+
+	ErrorReport errors;
+	for (std::size_t i = 0; i < 7; i++) {
+		for (std::size_t j = 0; j <= i; j++)
+			errors.Add(ErrorReport::Kind::kInvalidEntry, std::format("{}_SRD.json", i), std::format("entry {} has no Form", j));
+	}
+
+	const auto summary = errors.Flush();
+	CHECK(summary.starts_with(std::format("{} found 28 problems in 7 configs\n", Core::NAME)));
+	CHECK(summary.contains("\n6_SRD.json: 7\n5_SRD.json: 6\n4_SRD.json: 5\n3_SRD.json: 4\n2_SRD.json: 3\n...and 2 more"sv));
+}
@@ -0,0 +1,76 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Identifier.h"
+#include "MockBackend.h"
+
+TEST_CASE("Identifier::Parse accepts either order", "[identifier]")
+{
+	const auto pluginFirst = Identifier::Parse("Skyrim.esm|0x800"sv);
+	REQUIRE(pluginFirst);
+	CHECK(pluginFirst->plugin == "Skyrim.esm"sv);
+	CHECK(pluginFirst->localID == 0x800u);
+
+	const auto idFirst = Identifier::Parse("800|Skyrim.esm"sv);
+	REQUIRE(idFirst);
+	CHECK(idFirst->plugin == "Skyrim.esm"sv);
+	CHECK(idFirst->localID == 0x800u);
+
+	const auto padded = Identifier::Parse(" 0xABC \t|  Dawnguard.esm "sv);
+	REQUIRE(padded);
+	CHECK(padded->plugin == "Dawnguard.esm"sv);
+	CHECK(padded->localID == 0xABCu);
+}
+
+TEST_CASE("Identifier::Parse rejects anything else", "[identifier]")
+{
+	CHECK_FALSE(Identifier::Parse("WPNPickUpSword"sv));
+	CHECK_FALSE(Identifier::Parse("|"sv));
+	CHECK_FALSE(Identifier::Parse("Skyrim.esm|"sv));
+	CHECK_FALSE(Identifier::Parse("Skyrim.esm|0x"sv));
+	CHECK_FALSE(Identifier::Parse("Skyrim.esm|80G"sv));
+	CHECK_FALSE(Identifier::Parse("Skyrim|800"sv));
+}
+
+TEST_CASE("Identifier::Lookup resolves FormIDs and EditorIDs", "[identifier]")
+{
+	MockBackend backend;
+	const auto sound = backend.AddForm(FormType::kSoundDescriptor, "Skyrim.esm"sv, 0x800, "WPNPickUpSword"sv);
+
+	CHECK(Identifier::Lookup(backend, "Skyrim.esm|0x800"sv) == sound);
+	CHECK(Identifier::Lookup(backend, "800|skyrim.esm"sv) == sound);
+	CHECK(Identifier::Lookup(backend, "WPNPickUpSword"sv) == sound);
+	CHECK(Identifier::Lookup(backend, "Skyrim.esm|0x801"sv) == nullptr);
+	CHECK(Identifier::Lookup(backend, "Update.esm|0x800"sv) == nullptr);
+	CHECK(Identifier::Lookup(backend, "WPNPutDownSword"sv) == nullptr);
+	CHECK(backend.GetIdentifier(sound) == "WPNPickUpSword");
+}
+
+TEST_CASE("MockBackend keeps forms of every plugin apart", "[identifier]")
+{
+	MockBackend backend;
+	std::vector<Form*> forms;
+	for (std::uint32_t i = 0; i < 300; i++)
+		forms.push_back(backend.AddForm(FormType::kSoundDescriptor, std::format("Plugin{}.esp", i), 0x800));
+
+	std::unordered_set<FormID> formIDs;
+	for (std::uint32_t i = 0; i < forms.size(); i++) {
+		CHECK(Identifier::Lookup(backend, std::format("Plugin{}.esp|0x800", i)) == forms[i]);
+		CHECK(backend.LookupFormID(backend.GetFormID(forms[i])) == forms[i]);
+		CHECK(backend.GetIdentifier(forms[i]) == std::format("800|Plugin{}.esp", i));
+		formIDs.insert(backend.GetFormID(forms[i]));
+	}
+	CHECK(formIDs.size() == forms.size());
+}
+
+TEST_CASE("MockBackend accepts derived form types", "[identifier]")
+{
+	MockBackend backend;
+	const auto soulGem = backend.AddForm(FormType::kSoulGem, "Skyrim.esm"sv, 0x2E4E2);
+	const auto miscItem = backend.AddForm(FormType::kMiscItem, "Skyrim.esm"sv, 0xA);
+
+	CHECK(backend.IsFormType(soulGem, FormType::kSoulGem));
+	CHECK(backend.IsFormType(soulGem, FormType::kMiscItem));
+	CHECK(backend.IsFormType(miscItem, FormType::kMiscItem));
+	CHECK_FALSE(backend.IsFormType(miscItem, FormType::kSoulGem));
+	CHECK_FALSE(backend.IsFormType(soulGem, FormType::kSoundDescriptor));
+}
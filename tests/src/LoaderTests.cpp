@@ -0,0 +1,433 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Loader.h"
+#include "MockBackend.h"
+#include "Settings.h"
+
+namespace
+{
+	// Configs found in a_directory, keyed the way the loader keeps them
+	struct FoundConfigs
+	{
+		explicit FoundConfigs(const std::filesystem::path& a_directory)
+		{
+			Loader::FindConfigs(a_directory, [this](const std::string& a_path, std::string_view a_plugin) {
+				if (a_plugin.empty())
+					configs.insert(a_path);
+				else
+					pluginConfigs[std::string{ a_plugin }].insert(a_path);
+			});
+		}
+
+		std::vector<std::string> GetApplyOrder(std::span<const std::string> a_loadOrder) const
+		{
+			return Loader::GetApplyOrder(a_loadOrder, configs, pluginConfigs);
+		}
+
+		Loader::ConfigSet configs;
+		StringUtil::CaseInsensitiveMap<Loader::ConfigSet> pluginConfigs;
+	};
+
+	void WriteFile(const std::filesystem::path& a_path, std::string_view a_data)
+	{
+		std::ofstream o(a_path, std::ios::binary | std::ios::trunc);
+		o.write(a_data.data(), a_data.size());
+	}
+
+	// An empty directory of its own for each test, removed afterwards
+	struct TempDirectory
+	{
+		explicit TempDirectory(std::string_view a_name) :
+			path(std::filesystem::temp_directory_path() / std::format("{}Tests", Core::NAME) / a_name)
+		{
+			std::filesystem::remove_all(path);
+			std::filesystem::create_directories(path);
+		}
+
+		~TempDirectory()
+		{
+			std::error_code ec;
+			std::filesystem::remove_all(path, ec);
+		}
+
+		void Write(std::string_view a_name, std::string_view a_data) const
+		{
+			WriteFile(path / a_name, a_data);
+		}
+
+		std::filesystem::path path;
+	};
+
+	// Loads the configs of a data directory of its own through MockBackend, as the plugin does through the game
+	struct LoaderTest
+	{
+		explicit LoaderTest(std::string_view a_name) :
+			data(a_name)
+		{
+			spdlog::set_level(spdlog::level::off);
+			backend.AddPlugin("Skyrim.esm"sv);
+			backend.AddPlugin("Update.esm"sv);
+			weapon = backend.AddForm(FormType::kWeapon, "Skyrim.esm"sv, 0x12EB7, "IronSword"sv);
+			original = AddSound("WPNPickUpSword"sv);
+			backend.SetField(weapon, Records::Category::kWeapons, Field::kPickUp, original);
+			options.dataDirectory = data.path;
+		}
+
+		Form* AddSound(std::string_view a_editorID)
+		{
+			return backend.AddForm(FormType::kSoundDescriptor, "Skyrim.esm"sv, nextSound++, a_editorID);
+		}
+
+		Form* GetPickUp() { return backend.GetField(weapon, Records::Category::kWeapons, Field::kPickUp); }
+
+		// A config setting the sword's pick up sound
+		void WriteConfig(std::string_view a_name, std::string_view a_pickUp, std::string_view a_requirements = "[]"sv) const
+		{
+			data.Write(a_name, std::format(R"({{ "Requirements": {}, "Weapons": [ {{ "Form": "IronSword", "Pick Up": "{}" }} ] }})", a_requirements, a_pickUp));
+		}
+
+		std::unique_ptr<Loader> Load()
+		{
+			auto loader = std::make_unique<Loader>(backend, options);
+			loader->Load();
+			loader->WaitForReport();
+			return loader;
+		}
+
+		TempDirectory data;
+		MockBackend backend;
+		Loader::Options options;
+		Form* weapon;
+		Form* original;
+		FormID nextSound = 0x800;
+	};
+
+	std::vector<std::string> GetFilenames(std::span<const std::string> a_paths)
+	{
+		std::vector<std::string> filenames;
+		for (const auto& path : a_paths)
+			filenames.push_back(std::filesystem::path(path).filename().string());
+		return filenames;
+	}
+
+	// Filenames of the configs the last Load applied, in the order it applied them
+	std::vector<std::string> GetAppliedFilenames(const Loader& a_loader)
+	{
+		std::vector<std::string> filenames;
+		for (const auto& file : a_loader.GetStats().files)
+			filenames.push_back(std::filesystem::path(file.name).filename().string());
+		return filenames;
+	}
+}
+
+TEST_CASE("GetPluginPrefixes finds every plugin name a config may belong to", "[loader]")
+{
+	CHECK(StringUtil::GetPluginPrefixes("Skyrim.esm_SRD"sv) == std::vector{ "Skyrim.esm"sv });
+	CHECK(StringUtil::GetPluginPrefixes("My.Esports.esp_SRD"sv) == std::vector{ "My.Esp"sv, "My.Esports.esp"sv });
+	CHECK(StringUtil::GetPluginPrefixes("Sounds_SRD"sv).empty());
+}
+
+TEST_CASE("Plugin configs apply in load order, then the rest", "[loader]")
+{
+	const TempDirectory directory{ "ApplyOrder" };
+	for (const auto name : { "A_SRD.json"sv, "Update.esm_SRD.json"sv, "Skyrim.esm_B_SRD.yaml"sv, "Skyrim.esm_A_SRD.json"sv, "Missing.esp_SRD.json"sv, "Readme.txt"sv })
+		directory.Write(name, "{}"sv);
+
+	const FoundConfigs found{ directory.path };
+	const std::vector<std::string> loadOrder{ "Skyrim.esm", "Update.esm" };
+	CHECK(GetFilenames(found.GetApplyOrder(loadOrder)) == std::vector<std::string>{ "Skyrim.esm_A_SRD.json", "Skyrim.esm_B_SRD.yaml", "Update.esm_SRD.json", "A_SRD.json" });
+
+	// Plugins are matched regardless of case and follow the load order, not the names
+	const std::vector<std::string> reversed{ "update.esm", "skyrim.esm" };
+	CHECK(GetFilenames(found.GetApplyOrder(reversed)) == std::vector<std::string>{ "Update.esm_SRD.json", "Skyrim.esm_A_SRD.json", "Skyrim.esm_B_SRD.yaml", "A_SRD.json" });
+}
+
+TEST_CASE("Plugin configs go with the longest loaded plugin their name starts with", "[loader]")
+{
+	const TempDirectory directory{ "PluginPrefixes" };
+	directory.Write("My.Esports.esp_SRD.json"sv, "{}"sv);
+	const FoundConfigs found{ directory.path };
+
+	const std::vector<std::string> loadOrder{ "Skyrim.esm", "My.Esports.esp" };
+	CHECK(GetFilenames(found.GetApplyOrder(loadOrder)) == std::vector<std::string>{ "My.Esports.esp_SRD.json" });
+
+	// A shorter plugin name is only used when it is the one loaded
+	const std::vector<std::string> shorter{ "My.Esp" };
+	CHECK(GetFilenames(found.GetApplyOrder(shorter)) == std::vector<std::string>{ "My.Esports.esp_SRD.json" });
+
+	const std::vector<std::string> neither{ "Skyrim.esm" };
+	CHECK(found.GetApplyOrder(neither).empty());
+}
+
+TEST_CASE("Loader only applies configs whose requirements hold", "[loader][requirements]")
+{
+	LoaderTest test{ "Requirements" };
+	const auto met = test.AddSound("SoundMet"sv);
+	test.AddSound("SoundUnmet"sv);
+	test.WriteConfig("A_SRD.json"sv, "SoundMet"sv, R"([ "Skyrim.esm", { "Any": [ "Dawnguard.esm", "Update.esm" ] } ])"sv);
+	test.WriteConfig("B_SRD.json"sv, "SoundUnmet"sv, R"([ { "None": [ "Update.esm" ] } ])"sv);
+
+	const auto loader = test.Load();
+	CHECK(test.GetPickUp() == met);
+	CHECK(loader->GetStats().fieldsWritten == 1);
+	// An unmet requirement is not an error
+	CHECK(test.backend.GetMessageCount() == 0);
+}
+
+TEST_CASE("Loader applies plugin configs in load order, then the rest", "[loader]")
+{
+	LoaderTest test{ "LoadOrder" };
+	test.backend.AddPlugin("Dawnguard.esm"sv);
+	test.backend.AddPlugin("My.Esports.esp"sv);
+	const auto dawnguard = test.AddSound("SoundDawnguard"sv);
+	const auto esports = test.AddSound("SoundEsports"sv);
+	const auto general = test.AddSound("SoundGeneral"sv);
+	test.AddSound("SoundUpdate"sv);
+	test.AddSound("SoundMissing"sv);
+
+	// Dawnguard.esm is named first but loaded after Update.esm
+	test.WriteConfig("Dawnguard.esm_SRD.json"sv, "SoundDawnguard"sv);
+	test.WriteConfig("Update.esm_SRD.json"sv, "SoundUpdate"sv);
+	test.WriteConfig("Missing.esp_SRD.json"sv, "SoundMissing"sv);
+	test.Load();
+	CHECK(test.GetPickUp() == dawnguard);
+
+	test.WriteConfig("My.Esports.esp_SRD.json"sv, "SoundEsports"sv);
+	const auto loader = test.Load();
+	CHECK(test.GetPickUp() == esports);
+	CHECK(GetAppliedFilenames(*loader) == std::vector<std::string>{ "Update.esm_SRD.json", "Dawnguard.esm_SRD.json", "My.Esports.esp_SRD.json" });
+
+	// General configs apply after every plugin config, whatever their names
+	test.WriteConfig("A_SRD.json"sv, "SoundGeneral"sv);
+	test.Load();
+	CHECK(test.GetPickUp() == general);
+}
+
+TEST_CASE("Loader applies more configs than the pipeline looks ahead in order", "[loader]")
+{
+	LoaderTest test{ "Window" };
+	const auto count = 3 * std::max(2u, std::thread::hardware_concurrency() * 2) + 1;
+	std::vector<std::string> names;
+	for (std::size_t i = 0; i < count; i++) {
+		const auto name = std::format("Sound{:04}", i);
+		test.AddSound(name);
+		test.WriteConfig(std::format("{}_SRD.json", name), name);
+		names.push_back(std::format("{}_SRD.json", name));
+	}
+
+	const auto loader = test.Load();
+	CHECK(test.backend.GetIdentifier(test.GetPickUp()) == std::format("Sound{:04}", count - 1));
+	CHECK(GetAppliedFilenames(*loader) == names);
+	CHECK(loader->GetStats().fieldsPlanned == count);
+}
+
+TEST_CASE("ConfigPipeline hands back configs in the order they are taken", "[loader]")
+{
+	const TempDirectory directory{ "Pipeline" };
+	std::vector<std::string> paths;
+	for (const auto name : { "A_SRD.json"sv, "B_SRD.json"sv, "C_SRD.json"sv, "D_SRD.yaml"sv, "E_SRD.json"sv }) {
+		directory.Write(name, name.ends_with(".yaml"sv) ? "Weapons:\n  - Form: IronSword\n    Pick Up: SoundD\n"sv : R"({ "Weapons": [ { "Form": "IronSword", "Pick Up": "Sound" } ] })"sv);
+		paths.push_back((directory.path / name).string());
+	}
+	directory.Write("Bad_SRD.json"sv, "{"sv);
+	paths.push_back((directory.path / "Bad_SRD.json").string());
+
+	ConfigPipeline pipeline{ nullptr, 2 };
+	for (const auto& path : paths)
+		pipeline.Push(path);
+
+	// Files left out of the order are dropped, and loaded on the spot if they are asked for after all
+	const std::vector<std::string> order{ paths[5], paths[4], paths[3], paths[0] };
+	pipeline.SetOrder(order);
+	for (const auto& path : { paths[4], paths[3], paths[0], paths[1] }) {
+		const auto config = pipeline.Take(path);
+		CHECK(config.path == path);
+		CHECK(config.error.empty());
+		CHECK(config.data.GetRecordCount() == 1);
+	}
+
+	const auto bad = pipeline.Take(paths[5]);
+	CHECK_FALSE(bad.error.empty());
+	CHECK(bad.data.GetRecordCount() == 0);
+
+	const auto missing = pipeline.Take((directory.path / "Missing_SRD.json").string());
+	CHECK_FALSE(missing.error.empty());
+}
+
+TEST_CASE("Loader reuses cached configs and forms until they change", "[loader][cache]")
+{
+	LoaderTest test{ "Cache" };
+	const TempDirectory cacheDirectory{ "CacheFile" };
+	test.options.cacheFile = cacheDirectory.path / "Cache.bin";
+	const auto first = test.AddSound("SoundA"sv);
+	const auto second = test.AddSound("SoundBB"sv);
+	test.WriteConfig("A_SRD.json"sv, "SoundA"sv);
+
+	// Nothing is cached on the first load, the IronSword and SoundA identifiers are resolved through the backend
+	auto loader = test.Load();
+	CHECK(test.GetPickUp() == first);
+	CHECK(loader->GetStats().configCacheMisses == 1);
+	CHECK(loader->GetStats().formCacheMisses == 2);
+	CHECK(std::filesystem::exists(test.options.cacheFile));
+
+	// Applied from the cache alone
+	test.backend.SetField(test.weapon, Records::Category::kWeapons, Field::kPickUp, test.original);
+	loader = test.Load();
+	CHECK(test.GetPickUp() == first);
+	CHECK(loader->GetStats().configCacheHits == 1);
+	CHECK(loader->GetStats().configCacheMisses == 0);
+	CHECK(loader->GetStats().formCacheHits == 2);
+	CHECK(loader->GetStats().formCacheMisses == 0);
+
+	// An edited config is parsed again
+	test.WriteConfig("A_SRD.json"sv, "SoundBB"sv);
+	loader = test.Load();
+	CHECK(test.GetPickUp() == second);
+	CHECK(loader->GetStats().configCacheMisses == 1);
+	CHECK(loader->GetStats().formCacheHits == 1);
+	CHECK(loader->GetStats().formCacheMisses == 1);
+
+	// A plugin updated in place invalidates every cached form, without touching the configs
+	test.backend.UpdatePlugin("Update.esm"sv);
+	loader = test.Load();
+	CHECK(loader->GetStats().configCacheHits == 1);
+	CHECK(loader->GetStats().formCacheHits == 0);
+	CHECK(loader->GetStats().formCacheMisses == 2);
+
+	// So does a change to the load order
+	loader = test.Load();
+	CHECK(loader->GetStats().formCacheHits == 2);
+	test.backend.AddPlugin("Dawnguard.esm"sv);
+	loader = test.Load();
+	CHECK(loader->GetStats().formCacheHits == 0);
+	CHECK(loader->GetStats().formCacheMisses == 2);
+	CHECK(test.GetPickUp() == second);
+}
+
+TEST_CASE("Reload reapplies edited configs and reverts removed ones", "[loader][reload]")
+{
+	struct HotReload
+	{
+		HotReload() { Settings::GetSingleton()->hotReload.enabled = true; }
+		~HotReload() { Settings::GetSingleton()->hotReload.enabled = false; }
+	} hotReload;
+
+	LoaderTest test{ "Reload" };
+	const auto soundA = test.AddSound("SoundA"sv);
+	const auto soundB = test.AddSound("SoundB"sv);
+	const auto soundC = test.AddSound("SoundCC"sv);
+	const auto region = test.backend.AddForm(FormType::kRegion, "Skyrim.esm"sv, 0x900, "RegionFalkreath"sv);
+	test.WriteConfig("A_SRD.json"sv, "SoundA"sv);
+	test.WriteConfig("B_SRD.json"sv, "SoundB"sv);
+	test.data.Write("C_SRD.json"sv, R"({ "Regions": [ { "Form": "RegionFalkreath", "RDSA": [ { "Sound": "SoundA", "Chance": 0.5 } ] } ] })"sv);
+
+	const auto loader = test.Load();
+	CHECK(test.GetPickUp() == soundB);
+	REQUIRE(test.backend.GetRegionSound(region, soundA));
+	CHECK(loader->Reload() == 0);
+
+	// The earlier config takes over the field again
+	std::filesystem::remove(test.data.path / "B_SRD.json");
+	CHECK(loader->Reload() == 1);
+	CHECK(test.GetPickUp() == soundA);
+	CHECK(loader->GetReloadStats().fieldsWritten == 1);
+
+	test.WriteConfig("A_SRD.json"sv, "SoundCC"sv);
+	CHECK(loader->Reload() == 1);
+	CHECK(test.GetPickUp() == soundC);
+
+	// A config added back falls into its place in the apply order
+	test.WriteConfig("B_SRD.json"sv, "SoundB"sv);
+	CHECK(loader->Reload() == 1);
+	CHECK(test.GetPickUp() == soundB);
+
+	// With nothing writing them anymore, the field and the added region sound go back to how they were before the load
+	std::filesystem::remove(test.data.path / "A_SRD.json");
+	std::filesystem::remove(test.data.path / "B_SRD.json");
+	std::filesystem::remove(test.data.path / "C_SRD.json");
+	CHECK(loader->Reload() == 3);
+	CHECK(test.GetPickUp() == test.original);
+	CHECK_FALSE(test.backend.GetRegionSound(region, soundA));
+
+	// Load statistics are kept apart from those of reloads
+	CHECK(loader->GetStats().files.size() == 3);
+}
+
+TEST_CASE("Loader searches the config directory and the data directory", "[loader][discovery]")
+{
+	LoaderTest test{ "Directories" };
+	const auto soundA = test.AddSound("SoundA"sv);
+	test.AddSound("SoundB"sv);
+	test.AddSound("SoundC"sv);
+	test.options.configDirectory = Loader::GetConfigDirectory(test.data.path);
+
+	// Without the config directory only the data directory is searched
+	test.WriteConfig("B_SRD.json"sv, "SoundB"sv);
+	auto loader = test.Load();
+	CHECK(GetAppliedFilenames(*loader) == std::vector<std::string>{ "B_SRD.json" });
+
+	// Configs from both apply by filename whichever directory holds them, one may share its name with one in the other
+	std::filesystem::create_directories(test.options.configDirectory);
+	WriteFile(test.options.configDirectory / "A_SRD.json", R"({ "Weapons": [ { "Form": "IronSword", "Pick Up": "SoundA" } ] })"sv);
+	WriteFile(test.options.configDirectory / "B_SRD.json", R"({ "Weapons": [ { "Form": "IronSword", "Put Down": "SoundC" } ] })"sv);
+	test.WriteConfig("C_SRD.json"sv, "SoundA"sv);
+	loader = test.Load();
+	CHECK(GetAppliedFilenames(*loader) == std::vector<std::string>{ "A_SRD.json", "B_SRD.json", "B_SRD.json", "C_SRD.json" });
+	CHECK(test.GetPickUp() == soundA);
+	CHECK(test.backend.GetIdentifier(test.backend.GetField(test.weapon, Records::Category::kWeapons, Field::kPutDown)) == "SoundC");
+}
+
+TEST_CASE("Loader reuses the configs found in a directory until it changes", "[loader][discovery]")
+{
+	LoaderTest test{ "DirectoryIndex" };
+	const TempDirectory cacheDirectory{ "DirectoryIndexCache" };
+	test.options.cacheFile = cacheDirectory.path / "Cache.bin";
+	test.options.configDirectory = Loader::GetConfigDirectory(test.data.path);
+	std::filesystem::create_directories(test.options.configDirectory);
+	test.AddSound("SoundA"sv);
+	const auto soundB = test.AddSound("SoundB"sv);
+	WriteFile(test.options.configDirectory / "A_SRD.json", R"({ "Weapons": [ { "Form": "IronSword", "Pick Up": "SoundA" } ] })"sv);
+
+	auto loader = test.Load();
+	CHECK(loader->GetStats().directoriesIndexed == 0);
+	CHECK(loader->GetStats().entriesScanned > 0);
+
+	loader = test.Load();
+	CHECK(loader->GetStats().directoriesIndexed == 2);
+	CHECK(loader->GetStats().entriesScanned == 0);
+	CHECK(GetAppliedFilenames(*loader) == std::vector<std::string>{ "A_SRD.json" });
+
+	// Adding a config changes the time of its directory only
+	test.WriteConfig("B_SRD.json"sv, "SoundB"sv);
+	loader = test.Load();
+	CHECK(loader->GetStats().directoriesIndexed == 1);
+	CHECK(GetAppliedFilenames(*loader) == std::vector<std::string>{ "A_SRD.json", "B_SRD.json" });
+	CHECK(test.GetPickUp() == soundB);
+
+	test.options.indexDirectories = false;
+	loader = test.Load();
+	CHECK(loader->GetStats().directoriesIndexed == 0);
+	CHECK(GetAppliedFilenames(*loader) == std::vector<std::string>{ "A_SRD.json", "B_SRD.json" });
+}
+
+TEST_CASE("Loader reports each problem once per config in one message", "[loader][errors]")
+{
+	LoaderTest test{ "Errors" };
+	test.backend.AddForm(FormType::kWeapon, "Skyrim.esm"sv, 0x13989, "SteelSword"sv);
+	test.data.Write("A_SRD.json"sv, R"({ "Weapons": [
+		{ "Form": "IronSword", "Pick Up": "SoundMissing" },
+		{ "Form": "SteelSword", "Pick Up": "SoundMissing" },
+		{ "Form": "SwordMissing", "Pick Up": "WPNPickUpSword" }
+	] })"sv);
+	test.data.Write("B_SRD.json"sv, "{ \"Weapons\": ["sv);
+
+	const auto loader = test.Load();
+	CHECK(loader->GetStats().missingForms == 3);
+	REQUIRE(test.backend.GetMessageCount() == 1);
+	// A missing record form only skips its entry, the missing sound is one error counted twice
+	const auto& summary = test.backend.GetMessages()[0];
+	CHECK(summary.starts_with(std::format("{} found 3 problems in 2 configs\n", Core::NAME)));
+	CHECK(summary.contains("\n1 unreadable configs"sv));
+	CHECK(summary.contains("\n2 missing forms"sv));
+	CHECK(test.GetPickUp() == test.original);
+}
@@ -0,0 +1,177 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "Identifier.h"
+#include "MockBackend.h"
+#include "PatchPlan.h"
+
+namespace
+{
+	constexpr auto& PICK_UP = Records::WEAPON_FIELDS[0];
+
+	// Resolves writes the way the loader does, an explicit null clears the field and a form of the wrong type does not exist
+	PatchPlan::Resolver MakeResolver(const PatchPlan& a_plan, Backend& a_backend)
+	{
+		return [&](const PatchPlan::Write& a_write, Records::Category, FormType a_formType, Form*& a_value) {
+			const auto identifier = a_plan.GetIdentifier(a_write.identifier);
+			if (!identifier) {
+				a_value = nullptr;
+				return true;
+			}
+			const auto form = Identifier::Lookup(a_backend, *identifier);
+			if (!form || !a_backend.IsFormType(form, a_formType))
+				return false;
+			a_value = form;
+			return true;
+		};
+	}
+
+	struct Fixture
+	{
+		Fixture()
+		{
+			weapon = backend.AddForm(FormType::kWeapon, "Skyrim.esm"sv, 0x12EB7, "IronSword"sv);
+			original = backend.AddForm(FormType::kSoundDescriptor, "Skyrim.esm"sv, 0x800, "WPNPickUpSword"sv);
+			first = backend.AddForm(FormType::kSoundDescriptor, "Skyrim.esm"sv, 0x801, "WPNPickUpSwordA"sv);
+			second = backend.AddForm(FormType::kSoundDescriptor, "Skyrim.esm"sv, 0x802, "WPNPickUpSwordB"sv);
+			region = backend.AddForm(FormType::kRegion, "Skyrim.esm"sv, 0x900, "RegionFalkreath"sv);
+			backend.SetField(weapon, Records::Category::kWeapons, Field::kPickUp, original);
+		}
+
+		Form* GetPickUp() { return backend.GetField(weapon, Records::Category::kWeapons, Field::kPickUp); }
+
+		MockBackend backend;
+		PatchPlan plan;
+		Form* weapon;
+		Form* original;
+		Form* first;
+		Form* second;
+		Form* region;
+	};
+}
+
+TEST_CASE("PatchPlan writes the last writer of each field", "[plan]")
+{
+	Fixture fixture;
+	auto& plan = fixture.plan;
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 0, "WPNPickUpSwordA"sv);
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 1, "Skyrim.esm|0x802"sv);
+
+	const auto stats = plan.Commit(MakeResolver(plan, fixture.backend), fixture.backend);
+	CHECK(fixture.GetPickUp() == fixture.second);
+	CHECK(stats.fields == 1);
+	CHECK(stats.writes == 2);
+	CHECK(stats.applied == 1);
+	CHECK(stats.failed == 0);
+	CHECK(stats.categoryApplied[std::to_underlying(Records::Category::kWeapons)] == 1);
+
+	// Nothing changed since, so nothing is written again
+	CHECK(plan.Commit(MakeResolver(plan, fixture.backend), fixture.backend).fields == 0);
+}
+
+TEST_CASE("PatchPlan orders writes by file rank", "[plan]")
+{
+	Fixture fixture;
+	auto& plan = fixture.plan;
+	plan.SetFileRank(0, 1);
+	plan.SetFileRank(1, 0);
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 0, "WPNPickUpSwordA"sv);
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 1, "WPNPickUpSwordB"sv);
+
+	plan.Commit(MakeResolver(plan, fixture.backend), fixture.backend);
+	CHECK(fixture.GetPickUp() == fixture.first);
+}
+
+TEST_CASE("PatchPlan falls back to an earlier writer", "[plan]")
+{
+	Fixture fixture;
+	auto& plan = fixture.plan;
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 0, "WPNPickUpSwordA"sv);
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 1, "WPNPickUpMissing"sv);
+	// A form of the wrong type does not exist either
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 2, "IronSword"sv);
+
+	const auto stats = plan.Commit(MakeResolver(plan, fixture.backend), fixture.backend);
+	CHECK(fixture.GetPickUp() == fixture.first);
+	CHECK(stats.applied == 1);
+	CHECK(stats.failed == 0);
+}
+
+TEST_CASE("PatchPlan leaves a field alone when no writer resolves", "[plan]")
+{
+	Fixture fixture;
+	auto& plan = fixture.plan;
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 0, "WPNPickUpMissing"sv);
+
+	const auto stats = plan.Commit(MakeResolver(plan, fixture.backend), fixture.backend);
+	CHECK(fixture.GetPickUp() == fixture.original);
+	CHECK(stats.applied == 0);
+	CHECK(stats.failed == 1);
+}
+
+TEST_CASE("PatchPlan clears a field for an explicit null", "[plan]")
+{
+	Fixture fixture;
+	auto& plan = fixture.plan;
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 0, std::nullopt);
+
+	plan.Commit(MakeResolver(plan, fixture.backend), fixture.backend);
+	CHECK(fixture.GetPickUp() == nullptr);
+}
+
+TEST_CASE("PatchPlan reverts fields of removed files", "[plan]")
+{
+	Fixture fixture;
+	auto& plan = fixture.plan;
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 0, "WPNPickUpSwordA"sv);
+	plan.AddField(fixture.weapon, Records::Category::kWeapons, PICK_UP, 1, "WPNPickUpSwordB"sv);
+	plan.Commit(MakeResolver(plan, fixture.backend), fixture.backend);
+	REQUIRE(fixture.GetPickUp() == fixture.second);
+
+	// The earlier writer takes over again
+	const std::array<std::uint32_t, 1> last{ 1 };
+	plan.RemoveFiles(last);
+	auto stats = plan.Commit(MakeResolver(plan, fixture.backend), fixture.backend);
+	CHECK(fixture.GetPickUp() == fixture.first);
+	CHECK(stats.applied == 1);
+
+	// With no writer left the field goes back to the value it had before the first commit
+	const std::array<std::uint32_t, 1> remaining{ 0 };
+	plan.RemoveFiles(remaining);
+	stats = plan.Commit(MakeResolver(plan, fixture.backend), fixture.backend);
+	CHECK(fixture.GetPickUp() == fixture.original);
+	CHECK(stats.reverted == 1);
+	CHECK(stats.failed == 0);
+}
+
+TEST_CASE("PatchPlan removes region sounds it added once their files are removed", "[plan]")
+{
+	Fixture fixture;
+	auto& plan = fixture.plan;
+	auto& backend = fixture.backend;
+	const auto existing = fixture.second;
+	backend.SetRegionSound(fixture.region, existing, { std::to_underlying(Records::RegionSoundFlag::kSnowy), 0.5f });
+
+	CHECK(plan.AddRegionSound(fixture.region, fixture.first, 0, std::nullopt, 0.25f));
+	CHECK(plan.AddRegionSound(fixture.region, existing, 0, std::to_underlying(Records::RegionSoundFlag::kPleasant), std::nullopt));
+	auto stats = plan.Commit(MakeResolver(plan, backend), backend);
+	CHECK(stats.added == 1);
+
+	const auto added = backend.GetRegionSound(fixture.region, fixture.first);
+	REQUIRE(added);
+	CHECK(added->flags == Records::REGION_SOUND_DEFAULT_FLAGS);
+	CHECK(added->chance == 0.25f);
+	const auto changed = backend.GetRegionSound(fixture.region, existing);
+	REQUIRE(changed);
+	CHECK(changed->flags == std::to_underlying(Records::RegionSoundFlag::kPleasant));
+	CHECK(changed->chance == 0.5f);
+
+	const std::array<std::uint32_t, 1> files{ 0 };
+	plan.RemoveFiles(files);
+	stats = plan.Commit(MakeResolver(plan, backend), backend);
+	CHECK(stats.reverted == 2);
+	CHECK_FALSE(backend.GetRegionSound(fixture.region, fixture.first));
+	const auto restored = backend.GetRegionSound(fixture.region, existing);
+	REQUIRE(restored);
+	CHECK(restored->flags == std::to_underlying(Records::RegionSoundFlag::kSnowy));
+	CHECK(restored->chance == 0.5f);
+}
@@ -0,0 +1,90 @@
+#include <catch2/catch_test_macros.hpp>
+
+#include "ConfigParser.h"
+#include "PluginTable.h"
+
+namespace
+{
+	ConfigData ParseRequirements(std::string_view a_requirements)
+	{
+		ConfigData data;
+		ConfigParser::ParseJSON(std::format(R"({{ "Requirements": {} }})", a_requirements), data);
+		return data;
+	}
+
+	bool Evaluate(PluginTable& a_table, std::string_view a_requirements)
+	{
+		return a_table.Compile(ParseRequirements(a_requirements)).Evaluate(a_table);
+	}
+
+	std::vector<std::string> Explain(PluginTable& a_table, std::string_view a_requirements)
+	{
+		return a_table.Compile(ParseRequirements(a_requirements)).Explain(a_table);
+	}
+
+	const std::vector<std::string> LOAD_ORDER{ "Skyrim.esm", "Update.esm", "Dawnguard.esm" };
+}
+
+TEST_CASE("Configs without requirements always apply", "[requirements]")
+{
+	PluginTable table{ LOAD_ORDER };
+	CHECK(table.Compile(ConfigData{}).Evaluate(table));
+	CHECK(Evaluate(table, "[]"));
+}
+
+TEST_CASE("Plain requirements need every plugin loaded, or absent with a trailing !", "[requirements]")
+{
+	PluginTable table{ LOAD_ORDER };
+	CHECK(Evaluate(table, R"([ "Skyrim.esm", "Dawnguard.esm" ])"));
+	CHECK(Evaluate(table, R"([ "skyrim.ESM" ])"));
+	CHECK(Evaluate(table, R"([ "Skyrim.esm", "Dragonborn.esm!" ])"));
+
+	CHECK_FALSE(Evaluate(table, R"([ "Skyrim.esm", "Dragonborn.esm" ])"));
+	CHECK(Explain(table, R"([ "Skyrim.esm", "Dragonborn.esm" ])") == std::vector<std::string>{ "Dragonborn.esm" });
+
+	CHECK_FALSE(Evaluate(table, R"([ "Update.esm!" ])"));
+	CHECK(Explain(table, R"([ "Update.esm!", "Dragonborn.esm!" ])") == std::vector<std::string>{ "NOT Update.esm" });
+}
+
+TEST_CASE("Any needs one entry to hold", "[requirements]")
+{
+	PluginTable table{ LOAD_ORDER };
+	CHECK(Evaluate(table, R"([ { "Any": [ "Dragonborn.esm", "Dawnguard.esm" ] } ])"));
+	CHECK(Evaluate(table, R"([ { "Any": [ "Dragonborn.esm", "HearthFires.esm", "Update.esm!", "Unofficial.esp!" ] } ])"));
+
+	const auto requirements = R"([ "Skyrim.esm", { "Any": [ "Dragonborn.esm", "Update.esm!" ] } ])"sv;
+	CHECK_FALSE(Evaluate(table, requirements));
+	CHECK(Explain(table, requirements) == std::vector<std::string>{ "Any(Dragonborn.esm, NOT Update.esm)" });
+}
+
+TEST_CASE("None needs every entry to fail", "[requirements]")
+{
+	PluginTable table{ LOAD_ORDER };
+	CHECK(Evaluate(table, R"([ { "None": [ "Dragonborn.esm", "HearthFires.esm" ] } ])"));
+	CHECK_FALSE(Evaluate(table, R"([ { "None": [ "Dragonborn.esm", "Dawnguard.esm" ] } ])"));
+	CHECK_FALSE(Evaluate(table, R"([ { "None": [ "Dragonborn.esm!" ] } ])"));
+}
+
+TEST_CASE("Groups nest", "[requirements]")
+{
+	PluginTable table{ LOAD_ORDER };
+	CHECK(Evaluate(table, R"([ { "All": [ "Skyrim.esm", { "Any": [ "Dragonborn.esm", { "None": [ "HearthFires.esm" ] } ] } ] } ])"));
+	CHECK_FALSE(Evaluate(table, R"([ { "Any": [ "Dragonborn.esm", { "All": [ "Skyrim.esm", "HearthFires.esm" ] } ] } ])"));
+
+	const auto requirements = R"([ "Update.esm", { "Any": [ "Dragonborn.esm", { "All": [ "HearthFires.esm" ] } ] }, { "None": [ "Dawnguard.esm" ] } ])"sv;
+	CHECK(Explain(table, requirements) == std::vector<std::string>{ "Any(Dragonborn.esm, All(HearthFires.esm))", "None(Dawnguard.esm)" });
+}
+
+TEST_CASE("Requirements reach plugins past the first mask word", "[requirements]")
+{
+	std::vector<std::string> loadOrder;
+	for (std::size_t i = 0; i < 150; i++)
+		loadOrder.push_back(std::format("Plugin{}.esp", i));
+	PluginTable table{ loadOrder };
+
+	CHECK(Evaluate(table, R"([ "Plugin0.esp", "Plugin64.esp", "Plugin149.esp" ])"));
+	CHECK_FALSE(Evaluate(table, R"([ "Plugin149.esp!" ])"));
+	CHECK(Evaluate(table, R"([ { "Any": [ "Plugin150.esp", "Plugin130.esp" ] } ])"));
+	CHECK(table.IsLoaded(table.Intern("plugin100.ESP")));
+	CHECK_FALSE(table.IsLoaded(table.Intern("Plugin150.esp")));
+}
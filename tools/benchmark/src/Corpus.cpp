@@ -0,0 +1,313 @@
+#include "Corpus.h"
+
+namespace
+{
+	constexpr std::array MASTERS{
+		"Skyrim.esm"sv,
+		"Update.esm"sv,
+		"Dawnguard.esm"sv,
+		"HearthFires.esm"sv,
+		"Dragonborn.esm"sv
+	};
+	constexpr std::size_t MOD_PLUGINS = 11;
+	// Named by requirements but never loaded
+	constexpr auto UNLOADED_PLUGIN = "SRDBench_Unloaded.esp"sv;
+
+	// Forms of each record type that overlapping records share
+	constexpr std::size_t SHARED_RECORDS = 64;
+	constexpr std::size_t SOUND_DESCRIPTORS = 4096;
+	constexpr std::size_t IMPACT_DATA_SETS = 256;
+	constexpr std::size_t FOOTSTEP_SETS = 256;
+
+	constexpr std::array<std::string_view, 4> SOUND_FLAGS{
+		"Pleasant"sv,
+		"Cloudy"sv,
+		"Rainy"sv,
+		"Snowy"sv
+	};
+
+	constexpr std::array<std::string_view, 5> LOOSE_FILES{
+		"Mesh{:06}.bsa"sv,
+		"Patch{:06}.esp"sv,
+		"Settings{:06}.ini"sv,
+		"Data{:06}.json"sv,
+		"Readme{:06}.txt"sv
+	};
+
+	std::string Quote(std::optional<std::string_view> a_value)
+	{
+		return a_value ? std::format("\"{}\"", *a_value) : "null"s;
+	}
+}
+
+Corpus::Corpus(const Options& a_options) :
+	options(a_options),
+	random(a_options.seed)
+{
+	for (const auto master : MASTERS)
+		plugins.emplace_back(master);
+	for (std::size_t i = 0; i < MOD_PLUGINS; i++)
+		plugins.emplace_back(std::format("SRDBench_{:02}.esp", i));
+	nextLocalIDs.assign(plugins.size(), 0x800);
+
+	for (std::size_t i = 0; i < SOUND_DESCRIPTORS; i++)
+		pools[std::to_underlying(FormType::kSoundDescriptor)].push_back(AddForm(FormType::kSoundDescriptor));
+	for (std::size_t i = 0; i < IMPACT_DATA_SETS; i++)
+		pools[std::to_underlying(FormType::kImpactDataSet)].push_back(AddForm(FormType::kImpactDataSet));
+	for (std::size_t i = 0; i < FOOTSTEP_SETS; i++)
+		pools[std::to_underlying(FormType::kFootstepSet)].push_back(AddForm(FormType::kFootstepSet));
+	for (const auto formType : Records::CATEGORY_FORM_TYPES) {
+		for (std::size_t i = 0; i < SHARED_RECORDS; i++)
+			pools[std::to_underlying(formType)].push_back(AddForm(formType));
+	}
+
+	constexpr auto categoryCount = std::to_underlying(Records::Category::kTotal);
+	std::uniform_int_distribution<std::size_t> categoryDistribution{ 0, categoryCount - 1 };
+	std::uniform_int_distribution<std::size_t> recordDistribution{ 1, std::max<std::size_t>(1, options.records * 2 - 1) };
+	std::uniform_int_distribution<std::size_t> pluginDistribution{ MASTERS.size(), plugins.size() - 1 };
+
+	configs.reserve(options.configs);
+	for (std::size_t i = 0; i < options.configs; i++) {
+		auto& config = configs.emplace_back();
+		config.format = static_cast<Format>(random() % std::to_underlying(Format::kTotal));
+
+		if (Chance(0.1)) {
+			const auto& plugin = plugins[pluginDistribution(random)];
+			config.name = std::format("{}_Bench{:06}_SRD", plugin, i);
+			config.requirements.push_back(plugin);
+			stats.pluginConfigs++;
+		} else {
+			config.name = std::format("Bench{:06}_SRD", i);
+		}
+		if (Chance(0.05))
+			config.requirements.push_back(std::format("{}!", UNLOADED_PLUGIN));
+		else if (Chance(0.02))
+			config.requirements.emplace_back(UNLOADED_PLUGIN);
+		if (Chance(0.05)) {
+			config.anyRequirements.emplace_back(UNLOADED_PLUGIN);
+			config.anyRequirements.push_back(plugins[pluginDistribution(random)]);
+		}
+
+		std::array<Records::Category, 3> categories{};
+		const auto used = 1 + random() % categories.size();
+		for (std::size_t j = 0; j < used; j++)
+			categories[j] = static_cast<Records::Category>(categoryDistribution(random));
+
+		const auto records = recordDistribution(random);
+		for (std::size_t j = 0; j < records; j++) {
+			const auto category = categories[j % used];
+			config.records[std::to_underlying(category)].push_back(MakeRecord(category));
+		}
+		stats.records += records;
+	}
+}
+
+std::uint32_t Corpus::AddForm(FormType a_formType)
+{
+	const auto plugin = static_cast<std::uint32_t>(random() % plugins.size());
+	const auto index = static_cast<std::uint32_t>(forms.size());
+	forms.emplace_back(a_formType, plugin, nextLocalIDs[plugin]++, std::format("SRDBench{}{:06}", GetFormTypeName(a_formType), index));
+	return index;
+}
+
+std::uint32_t Corpus::PickForm(FormType a_formType)
+{
+	const auto& pool = pools[std::to_underlying(a_formType)];
+	return pool[random() % pool.size()];
+}
+
+bool Corpus::Chance(double a_probability)
+{
+	return std::bernoulli_distribution{ a_probability }(random);
+}
+
+std::string Corpus::GetIdentifier(std::uint32_t a_form)
+{
+	stats.references++;
+	if (Chance(options.missing))
+		return std::format("SRDBenchMissing{:06}", missingCount++);
+
+	const auto& form = forms[a_form];
+	switch (random() % 4) {
+	case 0:
+		return std::format("{}|0x{:X}", plugins[form.plugin], form.localID);
+	case 1:
+		return std::format("{:X}|{}", form.localID, plugins[form.plugin]);
+	default:
+		return form.editorID;
+	}
+}
+
+std::optional<std::string> Corpus::GetValue(FormType a_formType)
+{
+	if (Chance(0.01)) {
+		stats.references++;
+		return std::nullopt;
+	}
+	return GetIdentifier(PickForm(a_formType));
+}
+
+Corpus::Record Corpus::MakeRecord(Records::Category a_category)
+{
+	const auto formType = Records::GetFormType(a_category);
+
+	Record record;
+	record.form = GetIdentifier(Chance(options.overlap) ? PickForm(formType) : AddForm(formType));
+
+	if (a_category == Records::Category::kRegions) {
+		const auto count = 1 + random() % 3;
+		for (std::size_t i = 0; i < count; i++) {
+			auto& sound = record.sounds.emplace_back();
+			sound.sound = GetIdentifier(PickForm(FormType::kSoundDescriptor));
+			if (Chance(0.5)) {
+				std::string flags;
+				for (const auto flag : SOUND_FLAGS) {
+					if (Chance(0.5))
+						flags += flags.empty() ? std::string{ flag } : std::format(" {}", flag);
+				}
+				sound.flags = std::move(flags);
+			}
+			if (Chance(0.5))
+				sound.chance = static_cast<float>(random() % 100 + 1) / 100.0f;
+		}
+		return record;
+	}
+
+	for (const auto& field : Records::CATEGORY_FIELDS[std::to_underlying(a_category)]) {
+		if (Chance(0.5))
+			record.values.emplace_back(field.field, GetValue(field.valueType));
+	}
+	if (record.values.empty()) {
+		const auto& field = Records::CATEGORY_FIELDS[std::to_underlying(a_category)].front();
+		record.values.emplace_back(field.field, GetValue(field.valueType));
+	}
+	return record;
+}
+
+std::string Corpus::SerializeJSON(const Config& a_config, bool a_comments)
+{
+	std::string out = "{\n";
+	std::vector<std::string> sections;
+
+	if (!a_config.requirements.empty() || !a_config.anyRequirements.empty()) {
+		std::string section = a_comments ? "\t// Plugins this config needs, a trailing ! needs the plugin to be absent\n" : "";
+		section += "\t\"Requirements\": [";
+		for (std::size_t i = 0; i < a_config.requirements.size(); i++)
+			section += std::format("{}\"{}\"", i ? ", " : " ", a_config.requirements[i]);
+		if (!a_config.anyRequirements.empty()) {
+			section += std::format("{}{{ \"Any\": [", a_config.requirements.empty() ? " " : ", ");
+			for (std::size_t i = 0; i < a_config.anyRequirements.size(); i++)
+				section += std::format("{}\"{}\"", i ? ", " : " ", a_config.anyRequirements[i]);
+			section += " ] }";
+		}
+		section += " ]";
+		sections.push_back(std::move(section));
+	}
+
+	for (std::size_t i = 0; i < a_config.records.size(); i++) {
+		const auto& records = a_config.records[i];
+		if (records.empty())
+			continue;
+
+		std::string section = a_comments ? std::format("\t// {} records\n", records.size()) : "";
+		section += std::format("\t\"{}\": [\n", Records::CATEGORY_NAMES[i]);
+		for (std::size_t j = 0; j < records.size(); j++) {
+			const auto& record = records[j];
+			section += std::format("\t\t{{\n\t\t\t\"Form\": {}", Quote(record.form));
+			for (const auto& [field, value] : record.values)
+				section += std::format(",\n\t\t\t\"{}\": {}", GetFieldName(field), Quote(value));
+			if (!record.sounds.empty()) {
+				section += ",\n\t\t\t\"RDSA\": [\n";
+				for (std::size_t k = 0; k < record.sounds.size(); k++) {
+					const auto& sound = record.sounds[k];
+					section += std::format("\t\t\t\t{{ \"Sound\": {}", Quote(sound.sound));
+					if (sound.flags)
+						section += std::format(", \"Flags\": {}", Quote(*sound.flags));
+					if (sound.chance)
+						section += std::format(", \"Chance\": {}", *sound.chance);
+					section += k + 1 < record.sounds.size() ? " },\n" : " }\n";
+				}
+				section += "\t\t\t]";
+			}
+			section += j + 1 < records.size() ? "\n\t\t},\n" : "\n\t\t}\n";
+		}
+		section += "\t]";
+		sections.push_back(std::move(section));
+	}
+
+	for (std::size_t i = 0; i < sections.size(); i++) {
+		out += sections[i];
+		out += i + 1 < sections.size() ? ",\n" : "\n";
+	}
+	out += "}\n";
+	return out;
+}
+
+std::string Corpus::SerializeYAML(const Config& a_config)
+{
+	std::string out;
+	if (!a_config.requirements.empty() || !a_config.anyRequirements.empty()) {
+		out += "Requirements:\n";
+		for (const auto& requirement : a_config.requirements)
+			out += std::format("  - {}\n", Quote(requirement));
+		if (!a_config.anyRequirements.empty()) {
+			out += "  - Any:\n";
+			for (const auto& requirement : a_config.anyRequirements)
+				out += std::format("      - {}\n", Quote(requirement));
+		}
+	}
+
+	for (std::size_t i = 0; i < a_config.records.size(); i++) {
+		const auto& records = a_config.records[i];
+		if (records.empty())
+			continue;
+
+		out += std::format("{}:\n", Records::CATEGORY_NAMES[i]);
+		for (const auto& record : records) {
+			out += std::format("  - Form: {}\n", Quote(record.form));
+			for (const auto& [field, value] : record.values)
+				out += std::format("    {}: {}\n", GetFieldName(field), Quote(value));
+			if (!record.sounds.empty()) {
+				out += "    RDSA:\n";
+				for (const auto& sound : record.sounds) {
+					out += std::format("      - Sound: {}\n", Quote(sound.sound));
+					if (sound.flags)
+						out += std::format("        Flags: {}\n", Quote(*sound.flags));
+					if (sound.chance)
+						out += std::format("        Chance: {}\n", *sound.chance);
+				}
+			}
+		}
+	}
+	return out;
+}
+
+void Corpus::Write(const std::filesystem::path& a_directory)
+{
+	std::filesystem::remove_all(a_directory);
+	std::filesystem::create_directories(a_directory);
+
+	stats.files = {};
+	stats.bytes = {};
+	for (const auto& config : configs) {
+		const auto format = std::to_underlying(config.format);
+		const auto data = config.format == Format::kYAML ? SerializeYAML(config) : SerializeJSON(config, config.format == Format::kJSONC);
+		std::ofstream o(a_directory / std::format("{}{}", config.name, FORMAT_EXTENSIONS[format]), std::ios::binary | std::ios::trunc);
+		if (!o.good())
+			throw std::runtime_error(std::format("Failed to write {} to {}", config.name, a_directory.string()));
+		o.write(data.data(), data.size());
+		stats.files[format]++;
+		stats.bytes[format] += data.size();
+	}
+
+	for (std::size_t i = 0; i < options.looseFiles; i++)
+		std::ofstream(a_directory / std::vformat(LOOSE_FILES[i % LOOSE_FILES.size()], std::make_format_args(i)));
+}
+
+void Corpus::AddForms(MockBackend& a_backend) const
+{
+	for (const auto& plugin : plugins)
+		a_backend.AddPlugin(plugin);
+	for (const auto& form : forms)
+		a_backend.AddForm(form.formType, plugins[form.plugin], form.localID, form.editorID);
+}
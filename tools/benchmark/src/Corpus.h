@@ -0,0 +1,115 @@
+#pragma once
+
+#include "MockBackend.h"
+
+#include <random>
+
+// Synthetic set of _SRD configs and the forms they patch, generated from a seed so that runs are comparable
+class Corpus
+{
+public:
+	enum class Format : std::uint8_t
+	{
+		kJSON,
+		kJSONC,
+		kYAML,
+
+		kTotal
+	};
+
+	static constexpr std::array<std::string_view, std::to_underlying(Format::kTotal)> FORMAT_EXTENSIONS{
+		".json"sv,
+		".jsonc"sv,
+		".yaml"sv
+	};
+
+	struct Options
+	{
+		std::size_t configs = 1000;
+		// Records per config on average, spread over a few categories
+		std::size_t records = 20;
+		// Share of records patching forms that other configs patch as well, 0 gives every record its own form
+		double overlap = 0.25;
+		// Share of identifiers naming forms that do not exist
+		double missing = 0.01;
+		// Unrelated files next to the configs, as found in a real Data directory
+		std::size_t looseFiles = 5000;
+		std::uint32_t seed = 1;
+	};
+
+	struct Stats
+	{
+		std::array<std::size_t, std::to_underlying(Format::kTotal)> files{};
+		std::array<std::size_t, std::to_underlying(Format::kTotal)> bytes{};
+		std::size_t pluginConfigs = 0;
+		std::size_t records = 0;
+		std::size_t references = 0;
+	};
+
+	explicit Corpus(const Options& a_options);
+
+	// Replaces the contents of a_directory with the configs and loose files
+	void Write(const std::filesystem::path& a_directory);
+	// Adds the load order and every existing form the configs reference
+	void AddForms(MockBackend& a_backend) const;
+
+	const Stats& GetStats() const { return stats; }
+	std::size_t GetFormCount() const { return forms.size(); }
+
+private:
+	struct FormEntry
+	{
+		FormType formType;
+		std::uint32_t plugin;
+		FormID localID;
+		std::string editorID;
+	};
+
+	struct RegionSound
+	{
+		std::string sound;
+		std::optional<std::string> flags;
+		std::optional<float> chance;
+	};
+
+	struct Record
+	{
+		std::string form;
+		// A nullopt value is an explicit null, which clears the field
+		std::vector<std::pair<Field, std::optional<std::string>>> values;
+		std::vector<RegionSound> sounds;
+	};
+
+	struct Config
+	{
+		std::string name;
+		Format format;
+		std::vector<std::string> requirements;
+		// Written as an Any group after the plain requirements
+		std::vector<std::string> anyRequirements;
+		std::array<std::vector<Record>, std::to_underlying(Records::Category::kTotal)> records;
+	};
+
+	std::uint32_t AddForm(FormType a_formType);
+	std::uint32_t PickForm(FormType a_formType);
+	bool Chance(double a_probability);
+	// Identifier of a form in any of the accepted spellings, or of one that does not exist
+	std::string GetIdentifier(std::uint32_t a_form);
+	std::optional<std::string> GetValue(FormType a_formType);
+	Record MakeRecord(Records::Category a_category);
+
+	static std::string SerializeJSON(const Config& a_config, bool a_comments);
+	static std::string SerializeYAML(const Config& a_config);
+
+	Options options;
+	Stats stats;
+	std::mt19937 random;
+
+	std::vector<std::string> plugins;
+	std::vector<FormID> nextLocalIDs;
+	std::vector<FormEntry> forms;
+	// Forms of each type that records and values pick from
+	std::array<std::vector<std::uint32_t>, std::to_underlying(FormType::kTotal)> pools;
+	std::vector<Config> configs;
+	std::size_t missingCount = 0;
+};
@@ -0,0 +1,429 @@
+#include "ConfigParser.h"
+#include "ConfigPipeline.h"
+#include "Corpus.h"
+#include "FormCache.h"
+#include "Identifier.h"
+#include "Loader.h"
+#include "Log.h"
+#include "Settings.h"
+
+#include <iostream>
+#include <sstream>
+#include <nlohmann/json.hpp>
+#include <spdlog/sinks/null_sink.h>
+#include <tojson.hpp>
+
+using json = nlohmann::json;
+
+namespace
+{
+	constexpr auto USAGE = R"(Times every phase of loading a synthetic set of _SRD configs against in-memory forms.
+
+Usage: {} [options]
+
+  --configs <count>     Configs to generate (default 1000)
+  --records <count>     Records per config on average (default 20)
+  --overlap <share>     Share of records patching forms other configs patch too, 0 to 1 (default 0.25)
+  --missing <share>     Share of identifiers naming forms that do not exist, 0 to 1 (default 0.01)
+  --loose <count>       Unrelated files next to the configs (default 5000)
+  --seed <number>       Seed of the generated corpus (default 1)
+  --iterations <count>  Times each phase is run (default 5)
+  --directory <dir>     Where the corpus is written, replacing what is there (default a temporary directory)
+  --output <file>       Write the results here instead of stdout
+
+Results are JSON, with the minimum, median, mean and maximum milliseconds of each phase.
+)"sv;
+
+	struct Arguments
+	{
+		Corpus::Options corpus;
+		std::size_t iterations = 5;
+		std::filesystem::path directory = std::filesystem::temp_directory_path() / std::format("{}Benchmark", Core::NAME);
+		std::filesystem::path output;
+	};
+
+	template <class T>
+	bool ParseNumber(std::string_view a_value, T& a_number)
+	{
+		const auto end = a_value.data() + a_value.size();
+		const auto [ptr, ec] = std::from_chars(a_value.data(), end, a_number);
+		return ec == std::errc{} && ptr == end;
+	}
+
+	bool ParseArguments(std::span<char*> a_args, Arguments& a_arguments, std::string& a_error)
+	{
+		for (std::size_t i = 1; i < a_args.size(); i++) {
+			const std::string_view arg{ a_args[i] };
+			if (i + 1 == a_args.size()) {
+				a_error = std::format("Missing value for {}", arg);
+				return false;
+			}
+			const std::string_view value{ a_args[++i] };
+			bool valid = true;
+			if (arg == "--configs"sv) {
+				valid = ParseNumber(value, a_arguments.corpus.configs);
+			} else if (arg == "--records"sv) {
+				valid = ParseNumber(value, a_arguments.corpus.records) && a_arguments.corpus.records;
+			} else if (arg == "--overlap"sv) {
+				valid = ParseNumber(value, a_arguments.corpus.overlap) && a_arguments.corpus.overlap >= 0.0 && a_arguments.corpus.overlap <= 1.0;
+			} else if (arg == "--missing"sv) {
+				valid = ParseNumber(value, a_arguments.corpus.missing) && a_arguments.corpus.missing >= 0.0 && a_arguments.corpus.missing <= 1.0;
+			} else if (arg == "--loose"sv) {
+				valid = ParseNumber(value, a_arguments.corpus.looseFiles);
+			} else if (arg == "--seed"sv) {
+				valid = ParseNumber(value, a_arguments.corpus.seed);
+			} else if (arg == "--iterations"sv) {
+				valid = ParseNumber(value, a_arguments.iterations) && a_arguments.iterations;
+			} else if (arg == "--directory"sv) {
+				a_arguments.directory = value;
+			} else if (arg == "--output"sv) {
+				a_arguments.output = value;
+			} else {
+				a_error = std::format("Unknown option {}", arg);
+				return false;
+			}
+			if (!valid) {
+				a_error = std::format("Invalid value {} for {}", value, arg);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	double MillisecondsSince(std::chrono::steady_clock::time_point a_begin)
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - a_begin).count();
+	}
+
+	// Milliseconds each phase took in every iteration, kept in the order the phases first ran
+	class Results
+	{
+	public:
+		void Add(std::string_view a_phase, double a_milliseconds)
+		{
+			auto it = std::ranges::find(phases, a_phase, &Phase::first);
+			if (it == phases.end())
+				it = phases.insert(it, { std::string{ a_phase }, {} });
+			it->second.push_back(a_milliseconds);
+		}
+
+		json ToJSON() const
+		{
+			auto result = json::object();
+			for (auto [name, samples] : phases) {
+				std::ranges::sort(samples);
+				const auto middle = samples.size() / 2;
+				result[name] = {
+					{ "min", samples.front() },
+					{ "median", samples.size() % 2 ? samples[middle] : (samples[middle - 1] + samples[middle]) / 2.0 },
+					{ "mean", std::accumulate(samples.begin(), samples.end(), 0.0) / samples.size() },
+					{ "max", samples.back() }
+				};
+			}
+			return result;
+		}
+
+	private:
+		using Phase = std::pair<std::string, std::vector<double>>;
+
+		std::vector<Phase> phases;
+	};
+
+	struct Counts
+	{
+		std::size_t discovered = 0;
+		std::size_t parseErrors = 0;
+		std::size_t references = 0;
+		std::size_t unresolved = 0;
+		std::size_t formsLookedUp = 0;
+		std::size_t formIDIdentifiers = 0;
+		std::size_t formIDsParsed = 0;
+		std::size_t formIDsParsedByStream = 0;
+	};
+
+	Corpus::Format GetFormat(const std::string& a_path)
+	{
+		const auto extension = std::filesystem::path(a_path).extension();
+		for (std::size_t i = 0; i < Corpus::FORMAT_EXTENSIONS.size(); i++) {
+			if (extension == Corpus::FORMAT_EXTENSIONS[i])
+				return static_cast<Corpus::Format>(i);
+		}
+		return Corpus::Format::kJSON;
+	}
+
+	// Resolves every identifier of every config the way the loader does, once per unique identifier and type
+	void Resolve(Backend& a_backend, std::span<const ParsedConfig> a_configs, FormCache& a_cache, Counts& a_counts)
+	{
+		const auto resolve = [&](std::optional<std::string_view> a_identifier, FormType a_formType) {
+			if (!a_identifier)
+				return;
+			a_counts.references++;
+			if (a_cache.Find(*a_identifier, a_formType))
+				return;
+			auto form = Identifier::Lookup(a_backend, *a_identifier);
+			if (form && !a_backend.IsFormType(form, a_formType))
+				form = nullptr;
+			a_counts.unresolved += form == nullptr;
+			a_cache.Store(*a_identifier, a_formType, form);
+		};
+
+		for (const auto& config : a_configs) {
+			for (std::size_t i = 0; i < std::to_underlying(Records::Category::kTotal); i++) {
+				const auto category = static_cast<Records::Category>(i);
+				for (const auto& record : config.data.GetRecords(category)) {
+					resolve(config.data.GetString(record.form), Records::GetFormType(category));
+					for (const auto& value : config.data.GetValues(record)) {
+						if (const auto field = Records::FindField(category, value.field); field && field->valueType != FormType::kNone)
+							resolve(config.data.GetString(value.data), field->valueType);
+					}
+				}
+			}
+		}
+		a_counts.formsLookedUp = a_cache.GetSize();
+	}
+
+	// Every "Plugin|ID" identifier of every config, in the order they appear
+	std::vector<std::string_view> GetFormIDIdentifiers(std::span<const ParsedConfig> a_configs)
+	{
+		std::vector<std::string_view> identifiers;
+		const auto add = [&](std::optional<std::string_view> a_identifier) {
+			if (a_identifier && a_identifier->contains('|'))
+				identifiers.push_back(*a_identifier);
+		};
+		for (const auto& config : a_configs) {
+			for (std::size_t i = 0; i < std::to_underlying(Records::Category::kTotal); i++) {
+				const auto category = static_cast<Records::Category>(i);
+				for (const auto& record : config.data.GetRecords(category)) {
+					add(config.data.GetString(record.form));
+					for (const auto& value : config.data.GetValues(record)) {
+						if (const auto field = Records::FindField(category, value.field); field && field->valueType != FormType::kNone)
+							add(config.data.GetString(value.data));
+						else if (category == Records::Category::kRegions && value.field == Field::kSound)
+							add(config.data.GetString(value.data));
+					}
+				}
+			}
+		}
+		return identifiers;
+	}
+
+	// The istringstream parsing Identifier::Parse replaced, which took each identifier as a std::string
+	// and only understood "Plugin.esp|0x800"
+	bool ParseIdentifierStream(const std::string& a_identifier, std::string& a_plugin, FormID& a_localID)
+	{
+		std::istringstream ss{ a_identifier };
+		std::string id;
+		std::getline(ss, a_plugin, '|');
+		std::getline(ss, id);
+		a_localID = 0;
+		std::istringstream{ id } >> std::hex >> a_localID;
+		return !a_plugin.empty() && a_localID;
+	}
+
+	void RunIteration(const Corpus& a_corpus, const std::filesystem::path& a_data, const std::filesystem::path& a_reports, Results& a_results, Counts& a_counts)
+	{
+		a_counts = {};
+
+		auto begin = std::chrono::steady_clock::now();
+		std::vector<std::string> paths;
+		Loader::FindConfigs(a_data, [&](const std::string& a_path, std::string_view) {
+			paths.push_back(a_path);
+		});
+		a_results.Add("discovery", MillisecondsSince(begin));
+		a_counts.discovered = paths.size();
+
+		// Opening, reading and each format's parsing are timed on one thread, apart from each other
+		begin = std::chrono::steady_clock::now();
+		for (const auto& path : paths)
+			const ConfigFile file{ path };
+		a_results.Add("open", MillisecondsSince(begin));
+
+		begin = std::chrono::steady_clock::now();
+		std::vector<std::string> buffers(paths.size());
+		std::vector<ParsedConfig> configs(paths.size());
+		for (std::size_t i = 0; i < paths.size(); i++) {
+			ConfigFile file{ paths[i] };
+			ConfigPipeline::ReadConfig(file, paths[i], buffers[i], configs[i].error);
+		}
+		a_results.Add("read", MillisecondsSince(begin));
+
+		std::array<double, std::to_underlying(Corpus::Format::kTotal)> parseTimes{};
+		for (std::size_t i = 0; i < paths.size(); i++) {
+			auto& config = configs[i];
+			config.path = paths[i];
+			config.filename = std::filesystem::path(paths[i]).filename().string();
+			begin = std::chrono::steady_clock::now();
+			ConfigPipeline::ParseConfig(config, buffers[i]);
+			parseTimes[std::to_underlying(GetFormat(paths[i]))] += MillisecondsSince(begin);
+			if (!config.error.empty()) {
+				if (!a_counts.parseErrors)
+					std::cerr << config.error << "\n";
+				a_counts.parseErrors++;
+			}
+		}
+		for (std::size_t i = 0; i < parseTimes.size(); i++)
+			a_results.Add(std::format("parse{}", Corpus::FORMAT_EXTENSIONS[i]), parseTimes[i]);
+
+		// YAML again through a full JSON document, as it was parsed before the event-driven parser
+		begin = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < paths.size(); i++) {
+			if (GetFormat(paths[i]) != Corpus::Format::kYAML || !configs[i].error.empty())
+				continue;
+			ConfigData data;
+			ConfigParser::ParseDocument(tojson::yaml2json(buffers[i]), data);
+		}
+		a_results.Add("parse.yaml.tojson", MillisecondsSince(begin));
+		buffers.clear();
+
+		// The same work again through the worker pool, as the loader overlaps it with discovery and planning
+		begin = std::chrono::steady_clock::now();
+		{
+			ConfigPipeline pipeline;
+			for (const auto& path : paths)
+				pipeline.Push(path);
+			for (const auto& path : paths)
+				pipeline.Take(path);
+		}
+		a_results.Add("parse.pipeline", MillisecondsSince(begin));
+
+		// FormID identifiers parsed on their own, against the stream-based parser
+		{
+			const auto identifiers = GetFormIDIdentifiers(configs);
+			a_counts.formIDIdentifiers = identifiers.size();
+
+			begin = std::chrono::steady_clock::now();
+			for (const auto identifier : identifiers) {
+				if (const auto parsed = Identifier::Parse(identifier); parsed && parsed->localID)
+					a_counts.formIDsParsed++;
+			}
+			a_results.Add("identifiers.parse", MillisecondsSince(begin));
+
+			begin = std::chrono::steady_clock::now();
+			std::string plugin;
+			FormID localID;
+			for (const auto identifier : identifiers)
+				a_counts.formIDsParsedByStream += ParseIdentifierStream(std::string{ identifier }, plugin, localID);
+			a_results.Add("identifiers.parse.stream", MillisecondsSince(begin));
+		}
+
+		{
+			MockBackend backend;
+			a_corpus.AddForms(backend);
+			FormCache cache;
+			begin = std::chrono::steady_clock::now();
+			Resolve(backend, configs, cache, a_counts);
+			a_results.Add("resolve", MillisecondsSince(begin));
+		}
+		configs.clear();
+
+		// Everything together through the loader, against forms that nothing has patched yet
+		MockBackend backend;
+		a_corpus.AddForms(backend);
+		Loader::Options options;
+		options.dataDirectory = a_data;
+		options.reportDirectory = a_reports;
+		Loader loader{ backend, std::move(options) };
+
+		begin = std::chrono::steady_clock::now();
+		loader.Load();
+		loader.WaitForReport();
+		a_results.Add("load", MillisecondsSince(begin));
+
+		const auto& timings = loader.GetStats().timings;
+		a_results.Add("load.discovery", timings.discovery);
+		a_results.Add("load.parseWait", timings.parseWait);
+		a_results.Add("load.resolve", timings.resolve);
+		a_results.Add("load.apply", timings.plan + timings.commit);
+		a_results.Add("load.report", timings.report);
+		a_results.Add("load.write", timings.write);
+
+		// One config edited after loading, as when iterating on a mod in game
+		if (!paths.empty()) {
+			std::ofstream(paths[paths.size() / 2], std::ios::binary | std::ios::app) << "\n";
+			begin = std::chrono::steady_clock::now();
+			loader.Reload();
+			a_results.Add("reload", MillisecondsSince(begin));
+		}
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	Arguments arguments;
+	std::string error;
+	if (!ParseArguments({ a_argv, static_cast<std::size_t>(a_argc) }, arguments, error)) {
+		std::cerr << error << "\n\n"
+				  << std::format(USAGE, std::filesystem::path(a_argv[0]).filename().string());
+		return 2;
+	}
+
+	// Messages are formatted as in the game, but thrown away so that writing them does not skew the timings
+	const auto settings = Settings::GetSingleton();
+	settings->report.format = Settings::ReportFormat::kJSON;
+	settings->hotReload.enabled = true;
+	Log::Init(std::make_shared<spdlog::sinks::null_sink_mt>());
+
+	const auto data = arguments.directory / "Data";
+	const auto reports = arguments.directory / "Reports";
+
+	auto begin = std::chrono::steady_clock::now();
+	Corpus corpus{ arguments.corpus };
+	try {
+		corpus.Write(data);
+		std::filesystem::create_directories(reports);
+	} catch (const std::exception& exc) {
+		std::cerr << exc.what() << "\n";
+		return 2;
+	}
+	std::cerr << std::format("Generated {} configs in {:.0f} milliseconds\n", arguments.corpus.configs, MillisecondsSince(begin));
+
+	Results results;
+	Counts counts;
+	for (std::size_t i = 0; i < arguments.iterations; i++)
+		RunIteration(corpus, data, reports, results, counts);
+
+	const auto& stats = corpus.GetStats();
+	json files = json::object();
+	for (std::size_t i = 0; i < Corpus::FORMAT_EXTENSIONS.size(); i++)
+		files[std::string{ Corpus::FORMAT_EXTENSIONS[i].substr(1) }] = { { "files", stats.files[i] }, { "bytes", stats.bytes[i] } };
+
+	const json output = {
+		{ "corpus", {
+			{ "configs", arguments.corpus.configs },
+			{ "pluginConfigs", stats.pluginConfigs },
+			{ "records", stats.records },
+			{ "references", stats.references },
+			{ "forms", corpus.GetFormCount() },
+			{ "overlap", arguments.corpus.overlap },
+			{ "missing", arguments.corpus.missing },
+			{ "looseFiles", arguments.corpus.looseFiles },
+			{ "seed", arguments.corpus.seed },
+			{ "formats", files } } },
+		{ "threads", std::thread::hardware_concurrency() },
+		{ "iterations", arguments.iterations },
+		{ "counts", {
+			{ "discovered", counts.discovered },
+			{ "parseErrors", counts.parseErrors },
+			{ "references", counts.references },
+			{ "uniqueIdentifiers", counts.formsLookedUp },
+			{ "unresolved", counts.unresolved },
+			{ "formIDIdentifiers", counts.formIDIdentifiers },
+			{ "formIDsParsed", counts.formIDsParsed },
+			{ "formIDsParsedByStream", counts.formIDsParsedByStream } } },
+		{ "phases", results.ToJSON() }
+	};
+
+	if (arguments.output.empty()) {
+		std::cout << output.dump(1, '\t') << "\n";
+	} else {
+		std::ofstream o(arguments.output, std::ios::trunc);
+		if (!o.good()) {
+			std::cerr << std::format("Failed to write {}\n", arguments.output.string());
+			return 2;
+		}
+		o << output.dump(1, '\t') << "\n";
+	}
+
+	spdlog::shutdown();
+	return counts.parseErrors ? 1 : 0;
+}
@@ -0,0 +1,105 @@
+#include "FormDump.h"
+
+#include "Identifier.h"
+
+namespace
+{
+	constexpr std::string_view Trim(std::string_view a_string)
+	{
+		while (!a_string.empty() && (a_string.front() == ' ' || a_string.front() == '\t' || a_string.front() == '"'))
+			a_string.remove_prefix(1);
+		while (!a_string.empty() && (a_string.back() == ' ' || a_string.back() == '\t' || a_string.back() == '\r' || a_string.back() == '"'))
+			a_string.remove_suffix(1);
+		return a_string;
+	}
+
+	bool ReadFile(const std::filesystem::path& a_path, std::string& a_buffer, std::string& a_error)
+	{
+		std::ifstream i(a_path, std::ios::binary);
+		if (!i.good()) {
+			a_error = std::format("Failed to open {}", a_path.string());
+			return false;
+		}
+		i.seekg(0, std::ios::end);
+		a_buffer.resize(static_cast<std::size_t>(i.tellg()));
+		i.seekg(0, std::ios::beg);
+		i.read(a_buffer.data(), a_buffer.size());
+		return true;
+	}
+
+	template <class F>
+	void ForEachLine(std::string_view a_buffer, F&& a_func)
+	{
+		while (!a_buffer.empty()) {
+			const auto end = a_buffer.find('\n');
+			a_func(Trim(a_buffer.substr(0, end)));
+			if (end == std::string_view::npos)
+				break;
+			a_buffer.remove_prefix(end + 1);
+		}
+	}
+}
+
+bool FormDump::LoadPlugins(const std::filesystem::path& a_path, MockBackend& a_backend, std::string& a_error)
+{
+	std::string buffer;
+	if (!ReadFile(a_path, buffer, a_error))
+		return false;
+
+	bool marked = false;
+	ForEachLine(buffer, [&](std::string_view a_line) {
+		marked = marked || a_line.starts_with('*');
+	});
+	ForEachLine(buffer, [&](std::string_view a_line) {
+		if (a_line.empty() || a_line.starts_with('#'))
+			return;
+		const bool active = a_line.starts_with('*');
+		if (active)
+			a_line.remove_prefix(1);
+		if (active || !marked)
+			a_backend.AddPlugin(Trim(a_line));
+	});
+	return true;
+}
+
+bool FormDump::LoadForms(const std::filesystem::path& a_path, MockBackend& a_backend, Stats& a_stats, std::string& a_error)
+{
+	std::string buffer;
+	if (!ReadFile(a_path, buffer, a_error))
+		return false;
+
+	bool first = true;
+	ForEachLine(buffer, [&](std::string_view a_line) {
+		const bool header = first;
+		first = false;
+		if (a_line.empty() || a_line.starts_with('#'))
+			return;
+
+		std::array<std::string_view, 4> columns{};
+		std::size_t count = 0;
+		for (const auto column : std::views::split(a_line, ',')) {
+			if (count < columns.size())
+				columns[count] = Trim({ column.begin(), column.end() });
+			count++;
+		}
+		if (header && columns[0] == "EditorID"sv)
+			return;
+
+		const auto identifier = Identifier::Parse(columns[1]);
+		if (count < 3 || !identifier || !a_backend.IsPluginLoaded(identifier->plugin)) {
+			a_stats.invalid++;
+			return;
+		}
+		const auto formType = FindFormType(columns[2]);
+		if (!formType || *formType == FormType::kNone) {
+			a_stats.skipped++;
+			return;
+		}
+
+		const auto form = a_backend.AddForm(*formType, identifier->plugin, identifier->localID, columns[0]);
+		if (*formType == FormType::kRegion && columns[3] == "0"sv)
+			a_backend.SetHasRegionSounds(form, false);
+		a_stats.forms++;
+	});
+	return true;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "MockBackend.h"
+
+// Loads a load order and the forms of its plugins into a MockBackend
+namespace FormDump
+{
+	struct Stats
+	{
+		std::size_t forms = 0;
+		// Rows whose type no config can reference
+		std::size_t skipped = 0;
+		// Rows that could not be read, or whose plugin is not in the load order
+		std::size_t invalid = 0;
+	};
+
+	// One plugin per line as in plugins.txt, '#' starts a comment.
+	// If any line is marked active with a leading '*', unmarked plugins are left out.
+	bool LoadPlugins(const std::filesystem::path& a_path, MockBackend& a_backend, std::string& a_error);
+
+	// "EditorID,FormID,Type[,Sounds]" per line, where FormID is "Plugin.esp|0x800" or "800|Plugin.esp",
+	// Type is the record signature and Sounds is 0 for regions without sound data. A header line is skipped.
+	bool LoadForms(const std::filesystem::path& a_path, MockBackend& a_backend, Stats& a_stats, std::string& a_error);
+}
@@ -0,0 +1,141 @@
+#include "FormDump.h"
+#include "Loader.h"
+#include "Log.h"
+#include "Settings.h"
+
+#include <iostream>
+#include <spdlog/sinks/stdout_sinks.h>
+
+namespace
+{
+	constexpr auto USAGE = R"(Checks a modlist's _SRD configs without the game.
+
+Usage: {} --data <dir> --plugins <plugins.txt> --forms <forms.csv> [options]
+
+  --data <dir>          Data directory to search for configs
+  --plugins <file>      Load order, one plugin per line as in plugins.txt
+  --forms <file>        Form dump, "EditorID,FormID,Type[,Sounds]" per line
+  --report <format>     Conflict report to write: none, json or csv (default json)
+  --output <dir>        Directory the conflict report is written to (default .)
+  --cache <file>        Keep parsed configs and resolved forms here between runs
+  --stats               Also write load statistics to the output directory
+  --quiet               Only log warnings and errors
+
+Exits with 1 if any config has problems, 2 if the inputs could not be read.
+)"sv;
+
+	struct Arguments
+	{
+		std::filesystem::path data;
+		std::filesystem::path plugins;
+		std::filesystem::path forms;
+		std::filesystem::path output = ".";
+		std::filesystem::path cache;
+		Settings::ReportFormat report = Settings::ReportFormat::kJSON;
+		bool quiet = false;
+		bool stats = false;
+	};
+
+	bool ParseArguments(std::span<char*> a_args, Arguments& a_arguments, std::string& a_error)
+	{
+		for (std::size_t i = 1; i < a_args.size(); i++) {
+			const std::string_view arg{ a_args[i] };
+			if (arg == "--quiet"sv) {
+				a_arguments.quiet = true;
+				continue;
+			}
+			if (arg == "--stats"sv) {
+				a_arguments.stats = true;
+				continue;
+			}
+			if (i + 1 == a_args.size()) {
+				a_error = std::format("Missing value for {}", arg);
+				return false;
+			}
+			const std::string_view value{ a_args[++i] };
+			if (arg == "--data"sv) {
+				a_arguments.data = value;
+			} else if (arg == "--plugins"sv) {
+				a_arguments.plugins = value;
+			} else if (arg == "--forms"sv) {
+				a_arguments.forms = value;
+			} else if (arg == "--output"sv) {
+				a_arguments.output = value;
+			} else if (arg == "--cache"sv) {
+				a_arguments.cache = value;
+			} else if (arg == "--report"sv) {
+				if (value == "none"sv) {
+					a_arguments.report = Settings::ReportFormat::kNone;
+				} else if (value == "json"sv) {
+					a_arguments.report = Settings::ReportFormat::kJSON;
+				} else if (value == "csv"sv) {
+					a_arguments.report = Settings::ReportFormat::kCSV;
+				} else {
+					a_error = std::format("Unknown report format {}", value);
+					return false;
+				}
+			} else {
+				a_error = std::format("Unknown option {}", arg);
+				return false;
+			}
+		}
+		if (a_arguments.data.empty() || a_arguments.plugins.empty() || a_arguments.forms.empty()) {
+			a_error = "--data, --plugins and --forms are required";
+			return false;
+		}
+		return true;
+	}
+}
+
+int main(int a_argc, char* a_argv[])
+{
+	Arguments arguments;
+	std::string error;
+	if (!ParseArguments({ a_argv, static_cast<std::size_t>(a_argc) }, arguments, error)) {
+		std::cerr << error << "\n\n"
+				  << std::format(USAGE, std::filesystem::path(a_argv[0]).filename().string());
+		return 2;
+	}
+
+	const auto settings = Settings::GetSingleton();
+	settings->Load(arguments.data);
+	settings->report.format = arguments.report;
+	if (arguments.stats)
+		settings->report.stats = true;
+	settings->logging.async = false;
+	if (arguments.quiet) {
+		settings->logging.level = spdlog::level::warn;
+		settings->logging.categories.fill(spdlog::level::warn);
+	}
+
+	Log::Init(std::make_shared<spdlog::sinks::stderr_sink_mt>());
+	if (!settings->loadError.empty())
+		spdlog::error("{}", settings->loadError);
+
+	std::chrono::steady_clock::time_point begin = std::chrono::steady_clock::now();
+
+	MockBackend backend;
+	FormDump::Stats stats;
+	if (!FormDump::LoadPlugins(arguments.plugins, backend, error) || !FormDump::LoadForms(arguments.forms, backend, stats, error)) {
+		spdlog::critical("{}", error);
+		return 2;
+	}
+
+	std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+	spdlog::info("Loaded {} plugins and {} forms in {} milliseconds, skipped {} forms of other types and {} invalid rows", backend.GetPlugins().size(), stats.forms, std::chrono::duration_cast<std::chrono::milliseconds>(end - begin).count(), stats.skipped, stats.invalid);
+
+	Loader::Options options;
+	options.dataDirectory = arguments.data;
+	options.configDirectory = Loader::GetConfigDirectory(arguments.data);
+	options.cacheFile = arguments.cache;
+	options.reportDirectory = arguments.output;
+
+	Loader loader{ backend, std::move(options) };
+	loader.Load();
+	loader.WaitForReport();
+	spdlog::shutdown();
+
+	for (const auto& message : backend.GetMessages())
+		std::cout << message << "\n";
+	return backend.GetMessageCount() ? 1 : 0;
+}